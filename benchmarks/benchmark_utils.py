@@ -0,0 +1,87 @@
+'''Input files and helpers shared by the benchmarks'''
+from functools import lru_cache
+import os
+from pathlib import Path
+
+from eventio import EventIOFile
+from eventio.base import OffsetBytesIO
+
+
+resources = Path(__file__).parent.parent / 'tests' / 'resources'
+
+
+def _files(names, env):
+    paths = [str(resources / name) for name in names]
+    paths.extend(p for p in os.environ.get(env, '').split(os.pathsep) if p)
+    return paths
+
+
+simtel_files = _files([
+    'gamma_test.simtel.gz',
+    'gamma_20deg_0deg_run103___cta-prod4-sst-astri_desert-2150m-Paranal-sst-astri.simtel.gz',
+    'gamma_20deg_0deg_run102___cta-prod4-sst-1m_desert-2150m-Paranal-sst-1m.simtel.zst',
+    'lst_with_photons.simtel.zst',
+], 'EVENTIO_BENCHMARK_SIMTEL_FILES')
+
+
+iact_files = _files([
+    'one_shower.dat',
+    '3_gammas_reuse_5.dat',
+    'run102_gamma_za20deg_azm0deg-paranal-sst.corsika.zst',
+], 'EVENTIO_BENCHMARK_IACT_FILES')
+
+
+def file_id(path):
+    return Path(path).name
+
+
+@lru_cache()
+def uncompressed_size(path):
+    '''Size of the complete toplevel objects in the file in bytes'''
+    with EventIOFile(path) as f:
+        _, end = f.scan_objects()
+    return end
+
+
+def load_objects(path, eventio_type, max_objects=200):
+    '''The first `max_objects` objects of type `eventio_type` in the file,
+    with their payload read into memory, so that benchmarks of
+    their parsing do not include reading the file.
+    '''
+    objects = []
+
+    def walk(o):
+        if len(objects) >= max_objects:
+            return
+        if isinstance(o, eventio_type):
+            o.seek(0)
+            payload = o.read()
+            objects.append(eventio_type(
+                o.header, OffsetBytesIO(payload, o.header.content_address)
+            ))
+        elif o.header.only_subobjects:
+            for sub in o:
+                walk(sub)
+
+    with EventIOFile(path) as f:
+        for o in f:
+            walk(o)
+            if len(objects) >= max_objects:
+                break
+
+    return objects
+
+
+def report_rates(benchmark, n_events=None, n_bytes=None):
+    '''Add events/s and MB/s of the mean run time to the benchmark results'''
+    stats = getattr(benchmark, 'stats', None)
+    if stats is None:
+        # benchmarks disabled
+        return
+
+    mean = stats.stats.mean
+    if n_events is not None:
+        benchmark.extra_info['events_per_second'] = n_events / mean
+    if n_bytes is not None:
+        benchmark.extra_info['n_bytes'] = n_bytes
+        benchmark.extra_info['MB_per_second'] = n_bytes / mean / 1024**2
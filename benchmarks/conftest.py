@@ -0,0 +1,21 @@
+'''
+Benchmarks of pyeventio, run with
+
+    pytest benchmarks
+
+This requires pytest-benchmark, without it the benchmarks are skipped.
+pyhessio, if installed, is benchmarked on the same files as baseline.
+
+Besides the files in tests/resources, larger files can be added by setting
+EVENTIO_BENCHMARK_SIMTEL_FILES and EVENTIO_BENCHMARK_IACT_FILES
+to lists of paths separated by os.pathsep.
+
+To guard against performance regressions, save a baseline and compare against it:
+
+    pytest benchmarks --benchmark-autosave
+    pytest benchmarks --benchmark-compare --benchmark-compare-fail=mean:10%
+'''
+try:
+    import pytest_benchmark  # noqa: F401
+except ImportError:
+    collect_ignore_glob = ['test_*.py']
@@ -0,0 +1,69 @@
+'''
+Build the varint decoding functions of the hessioxxx reference implementation
+as a small shared library for the benchmarks.
+
+The kernels are extracted from hessioxxx-20181107/eventio.c
+by the same code as for the `eventio.simtel.hessio` extension,
+see hessio_kernels_source.py in the repository root.
+'''
+import ctypes
+from pathlib import Path
+import shutil
+import subprocess as sp
+import sys
+
+import numpy as np
+
+sys.path.insert(0, str(Path(__file__).parent.parent))
+import hessio_kernels_source  # noqa: E402
+
+
+wrappers = r'''
+size_t bench_get_count(BYTE *data, size_t size, size_t n, uint64_t *out) {
+    IO_BUFFER iobuf = {data, (long) size};
+    for (size_t i = 0; i < n; i++) {
+        out[i] = get_count(&iobuf);
+    }
+    return iobuf.data - data;
+}
+
+size_t bench_get_vector_of_uint32_scount_differential(
+    BYTE *data, size_t size, int num, uint32_t *out
+) {
+    IO_BUFFER iobuf = {data, (long) size};
+    get_vector_of_uint32_scount_differential(out, num, &iobuf);
+    return iobuf.data - data;
+}
+'''
+
+
+def build(directory):
+    '''Compile the hessio kernels in `directory`, returns the loaded library.
+    Raises RuntimeError if no C compiler is available.'''
+    compiler = shutil.which('cc') or shutil.which('gcc') or shutil.which('clang')
+    if compiler is None:
+        raise RuntimeError('No C compiler found')
+
+    code = hessio_kernels_source.kernel_source() + wrappers
+
+    directory = Path(directory)
+    c_file = directory / 'hessio_kernels.c'
+    library = directory / 'hessio_kernels.so'
+    c_file.write_text(code)
+    sp.run(
+        [compiler, '-O3', '-shared', '-fPIC', '-o', str(library), str(c_file)],
+        check=True, stdout=sp.PIPE, stderr=sp.STDOUT,
+    )
+
+    lib = ctypes.CDLL(str(library))
+    lib.bench_get_count.restype = ctypes.c_size_t
+    lib.bench_get_count.argtypes = [
+        ctypes.c_char_p, ctypes.c_size_t, ctypes.c_size_t,
+        np.ctypeslib.ndpointer(np.uint64, flags='C_CONTIGUOUS'),
+    ]
+    lib.bench_get_vector_of_uint32_scount_differential.restype = ctypes.c_size_t
+    lib.bench_get_vector_of_uint32_scount_differential.argtypes = [
+        ctypes.c_char_p, ctypes.c_size_t, ctypes.c_int,
+        np.ctypeslib.ndpointer(np.uint32, flags='C_CONTIGUOUS'),
+    ]
+    return lib
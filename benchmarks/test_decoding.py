@@ -0,0 +1,45 @@
+'''Benchmarks of decoding single object types, with the payloads already in memory'''
+import pytest
+
+from eventio.simtel.objects import ADCSamples, ADCSums, PixelTiming
+from eventio.iact.objects import Photons
+from benchmark_utils import simtel_files, iact_files, file_id, load_objects, report_rates
+
+
+def parse_all(objects):
+    for o in objects:
+        o.parse()
+
+
+def benchmark_parsing(benchmark, path, eventio_type):
+    objects = load_objects(path, eventio_type)
+    if not objects:
+        pytest.skip('No {} in {}'.format(eventio_type.__name__, file_id(path)))
+
+    benchmark.group = eventio_type.__name__
+    benchmark(parse_all, objects)
+    report_rates(
+        benchmark,
+        n_events=len(objects),
+        n_bytes=sum(o.header.content_size for o in objects),
+    )
+
+
+@pytest.mark.parametrize('path', simtel_files, ids=file_id)
+def test_adc_samples(benchmark, path):
+    benchmark_parsing(benchmark, path, ADCSamples)
+
+
+@pytest.mark.parametrize('path', simtel_files, ids=file_id)
+def test_adc_sums(benchmark, path):
+    benchmark_parsing(benchmark, path, ADCSums)
+
+
+@pytest.mark.parametrize('path', simtel_files, ids=file_id)
+def test_pixel_timing(benchmark, path):
+    benchmark_parsing(benchmark, path, PixelTiming)
+
+
+@pytest.mark.parametrize('path', iact_files + simtel_files, ids=file_id)
+def test_photons(benchmark, path):
+    benchmark_parsing(benchmark, path, Photons)
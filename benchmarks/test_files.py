@@ -0,0 +1,62 @@
+'''Benchmarks of reading complete files'''
+import pytest
+
+from eventio import EventIOFile, SimTelFile, IACTFile
+from benchmark_utils import simtel_files, iact_files, file_id, uncompressed_size, report_rates
+
+
+@pytest.mark.parametrize('path', simtel_files + iact_files, ids=file_id)
+def test_scan_objects(benchmark, path):
+    benchmark.group = 'scan_objects'
+
+    def scan():
+        with EventIOFile(path) as f:
+            index, _ = f.scan_objects(max_depth=1)
+        return len(index)
+
+    assert benchmark(scan) > 0
+    report_rates(benchmark, n_bytes=uncompressed_size(path))
+
+
+@pytest.mark.parametrize('path', simtel_files, ids=file_id)
+def test_simtel_file(benchmark, path):
+    benchmark.group = 'simtel_file:' + file_id(path)
+
+    def read():
+        with SimTelFile(path) as f:
+            return sum(1 for _ in f)
+
+    n_events = benchmark(read)
+    report_rates(benchmark, n_events=n_events, n_bytes=uncompressed_size(path))
+
+
+@pytest.mark.parametrize('path', simtel_files, ids=file_id)
+def test_pyhessio(benchmark, path):
+    '''Baseline: read the same files with the hessioxxx library'''
+    pyhessio = pytest.importorskip('pyhessio')
+    benchmark.group = 'simtel_file:' + file_id(path)
+
+    def read():
+        n_events = 0
+        with pyhessio.open_hessio(path) as h:
+            for _ in h.move_to_next_event():
+                for tel_id in h.get_teldata_list():
+                    h.get_adc_sum(tel_id)
+                    h.get_adc_sample(tel_id)
+                n_events += 1
+        return n_events
+
+    n_events = benchmark(read)
+    report_rates(benchmark, n_events=n_events, n_bytes=uncompressed_size(path))
+
+
+@pytest.mark.parametrize('path', iact_files, ids=file_id)
+def test_iact_file(benchmark, path):
+    benchmark.group = 'iact_file'
+
+    def read():
+        with IACTFile(path) as f:
+            return sum(1 for _ in f)
+
+    n_events = benchmark(read)
+    report_rates(benchmark, n_events=n_events, n_bytes=uncompressed_size(path))
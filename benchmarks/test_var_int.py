@@ -0,0 +1,178 @@
+'''
+Micro-benchmarks of the varint decoding kernels of `eventio.var_int`
+and the corresponding functions of the hessioxxx reference implementation,
+see `hessio_kernels`.
+Each benchmark also checks the decoded values.
+'''
+from functools import lru_cache
+
+import numpy as np
+import pytest
+
+from eventio.var_int import (
+    get_length_of_varint,
+    parse_varint,
+    unsigned_varint_array,
+    unsigned_varint_arrays_differential,
+    varint,
+    varint_array,
+)
+from benchmark_utils import report_rates
+import hessio_kernels
+from varint_data import (
+    distributions,
+    differential_values,
+    encode_differential,
+    encode_signed,
+    encode_unsigned,
+    signed_values,
+    unsigned_values,
+)
+
+
+sizes = [16, 1024, 65536]
+
+
+@pytest.fixture(scope='session')
+def hessio(tmp_path_factory):
+    try:
+        return hessio_kernels.build(tmp_path_factory.mktemp('hessio_kernels'))
+    except Exception as e:
+        pytest.skip('Could not build hessio kernels: {}'.format(e))
+
+
+@lru_cache()
+def differential_data(distribution, n):
+    values = differential_values(distribution, n).astype(np.uint32)
+    return values, encode_differential(values)
+
+
+@lru_cache()
+def unsigned_data(distribution, n):
+    values = unsigned_values(distribution, n)
+    return values, encode_unsigned(values)
+
+
+@lru_cache()
+def signed_data(distribution, n):
+    values = signed_values(distribution, n)
+    return values, encode_signed(values)
+
+
+def run(benchmark, group, n, data, func, *args):
+    benchmark.group = group
+    result = benchmark(func, *args)
+    report_rates(benchmark, n_events=n, n_bytes=len(data))
+    return result
+
+
+parametrize = pytest.mark.parametrize
+
+
+def cases(func):
+    '''Run the benchmark for all distributions and sizes'''
+    func = parametrize('n', sizes)(func)
+    return parametrize('distribution', distributions)(func)
+
+
+@cases
+@parametrize('simd', [True, False], ids=['simd', 'scalar'])
+def test_unsigned_varint_arrays_differential(benchmark, distribution, n, simd):
+    expected, data = differential_data(distribution, n)
+    result, length = run(
+        benchmark, 'differential-{}-{}'.format(distribution, n), n, data,
+        unsigned_varint_arrays_differential, data, 1, n, 0, simd,
+    )
+    assert length == len(data)
+    assert np.all(result[0] == expected)
+
+
+@cases
+def test_hessio_differential(benchmark, hessio, distribution, n):
+    expected, data = differential_data(distribution, n)
+    output = np.empty(n, dtype=np.uint32)
+    length = run(
+        benchmark, 'differential-{}-{}'.format(distribution, n), n, data,
+        hessio.bench_get_vector_of_uint32_scount_differential,
+        data, len(data), n, output,
+    )
+    assert length == len(data)
+    assert np.all(output == expected)
+
+
+@cases
+def test_unsigned_varint_array(benchmark, distribution, n):
+    expected, data = unsigned_data(distribution, n)
+    result, length = run(
+        benchmark, 'unsigned-{}-{}'.format(distribution, n), n, data,
+        unsigned_varint_array, data, n,
+    )
+    assert length == len(data)
+    assert np.all(result == expected)
+
+
+@cases
+def test_hessio_get_count(benchmark, hessio, distribution, n):
+    expected, data = unsigned_data(distribution, n)
+    output = np.empty(n, dtype=np.uint64)
+    length = run(
+        benchmark, 'unsigned-{}-{}'.format(distribution, n), n, data,
+        hessio.bench_get_count, data, len(data), n, output,
+    )
+    assert length == len(data)
+    assert np.all(output == expected)
+
+
+@cases
+def test_varint_array(benchmark, distribution, n):
+    expected, data = signed_data(distribution, n)
+    result, length = run(
+        benchmark, 'signed-{}-{}'.format(distribution, n), n, data,
+        varint_array, data, n,
+    )
+    assert length == len(data)
+    assert np.all(result == expected)
+
+
+def call_varint(data, n):
+    # one call per value, like the varints read in parse_1208 and PixelTiming
+    values = np.empty(n, dtype=np.int64)
+    offset = 0
+    for i in range(n):
+        values[i], length = varint(data, offset)
+        offset += length
+    return values, offset
+
+
+@cases
+def test_varint_calls(benchmark, distribution, n):
+    expected, data = signed_data(distribution, n)
+    result, length = run(
+        benchmark, 'signed-{}-{}'.format(distribution, n), n, data,
+        call_varint, data, n,
+    )
+    assert length == len(data)
+    assert np.all(result == expected)
+
+
+def call_parse_varint(data, n):
+    # one call per value on the bytes of the varint
+    values = np.empty(n, dtype=np.uint64)
+    view = memoryview(data)
+    offset = 0
+    for i in range(n):
+        length = get_length_of_varint(data[offset])
+        values[i] = parse_varint(view[offset:offset + length])
+        offset += length
+    return values, offset
+
+
+@cases
+def test_parse_varint(benchmark, distribution, n):
+    expected, data = unsigned_data(distribution, n)
+    result, length = run(
+        benchmark, 'unsigned-{}-{}'.format(distribution, n), n, data,
+        call_parse_varint, data, n,
+    )
+    assert length == len(data)
+    assert np.all(result == expected)
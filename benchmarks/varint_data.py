@@ -0,0 +1,81 @@
+'''
+Synthetic varint encoded data for the var_int benchmarks.
+
+The distributions approximate the byte lengths seen in real data:
+    one_byte:  all values fit into one byte, e.g. pedestal dominated ADC samples
+    mixed:     mostly one byte with some two and three byte values,
+               e.g. ADC samples with signal
+    five_byte: worst case, every value needs five bytes
+'''
+import numpy as np
+
+from eventio.tools import encode_unsigned_varint, encode_varint
+
+
+distributions = ('one_byte', 'mixed', 'five_byte')
+
+
+def differential_values(distribution, n, seed=0):
+    '''Values in the uint32 range, whose differences follow `distribution`'''
+    rng = np.random.default_rng(seed)
+
+    if distribution == 'one_byte':
+        steps = rng.integers(-64, 64, n)
+        steps[0] = 0
+        return np.abs(300 + np.cumsum(steps))
+
+    if distribution == 'mixed':
+        steps = rng.integers(-64, 64, n)
+        two_bytes = rng.random(n) < 0.12
+        steps[two_bytes] = rng.integers(-8192, 8192, np.count_nonzero(two_bytes))
+        three_bytes = rng.random(n) < 0.03
+        steps[three_bytes] = rng.integers(-2**19, 2**19, np.count_nonzero(three_bytes))
+        steps[0] = 0
+        return np.abs(300 + np.cumsum(steps)) % 2**20
+
+    if distribution == 'five_byte':
+        # alternate between low and high values, so all differences are
+        # larger than 2**27, but stay in the int32 range
+        values = rng.integers(0, 2**26, n)
+        values[1::2] += 2**30
+        return values
+
+    raise ValueError('Unknown distribution {}'.format(distribution))
+
+
+def encode_differential(values):
+    diffs = np.diff(np.asarray(values, dtype=np.int64), prepend=0)
+    return b''.join(encode_varint(int(d)) for d in diffs)
+
+
+def unsigned_values(distribution, n, seed=0):
+    rng = np.random.default_rng(seed)
+    if distribution == 'one_byte':
+        return rng.integers(0, 128, n, dtype=np.uint64)
+    if distribution == 'mixed':
+        values = rng.integers(0, 128, n, dtype=np.uint64)
+        two_bytes = rng.random(n) < 0.12
+        values[two_bytes] = rng.integers(128, 2**14, np.count_nonzero(two_bytes))
+        three_bytes = rng.random(n) < 0.03
+        values[three_bytes] = rng.integers(2**14, 2**21, np.count_nonzero(three_bytes))
+        return values
+    if distribution == 'five_byte':
+        return rng.integers(2**28, 2**35, n, dtype=np.uint64)
+
+    raise ValueError('Unknown distribution {}'.format(distribution))
+
+
+def encode_unsigned(values):
+    return b''.join(encode_unsigned_varint(int(v)) for v in values)
+
+
+def signed_values(distribution, n, seed=0):
+    values = unsigned_values(distribution, n, seed).astype(np.int64)
+    # zig-zag encoding of value // 2 with a random sign has about the
+    # same byte length as value
+    signs = np.random.default_rng(seed + 1).choice([-1, 1], n)
+    return signs * (values // 2)
+
+
+def encode_signed(values):
+    return b''.join(encode_varint(int(v)) for v in values)
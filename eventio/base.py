@@ -1,13 +1,39 @@
 import struct
 import gzip
 import logging
+import mmap
 import subprocess as sp
+import threading
+import queue
+from time import perf_counter
 import warnings
 
+import numpy as np
+
 from .file_types import is_gzip, is_eventio, is_zstd
-from .header import parse_header_bytes, get_bits_from_word
+from .sources import as_source, is_remote, open_binary
+from .header import (
+    parse_header_bytes,
+    get_bits_from_word,
+    scan_objects,
+    OBJECT_INDEX_DTYPE,
+)
 from . import constants
 from .exceptions import WrongType
+from .instrumentation import Instrumentation, timed_parse
+from .compression import (
+    BlockReader,
+    CheckpointedGzipReader,
+    CheckpointedZstdReader,
+    ParallelFrameReader,
+    decompress_gzip_member,
+    decompress_zstd_frame,
+    gzip_command,
+    is_bgzf,
+    is_multiframe_zstd,
+    iter_bgzf_blocks,
+    iter_zstd_frames,
+)
 
 try:
     import zstandard as zstd
@@ -22,33 +48,51 @@ log = logging.getLogger(__name__)
 
 KNOWN_OBJECTS = {}
 
+DEFAULT_READ_AHEAD_BLOCK_SIZE = 4 * 1024**2
+SKIP_BUFFER_SIZE = 64 * 1024
+
 
 class PipeWrapper:
     '''
     This class makes a sp.PIPE  forward-seekable
     by keeping track of the bytes already read
-    and reading as many bytes as required in `seek`
+    and reading as many bytes as required in `seek`.
+
+    Skipped bytes are read into a reused scratch buffer,
+    so seeking does not allocate memory for the skipped data.
     '''
     def __init__(self, pipe):
         self.pipe = pipe
         self.pos = 0
+        self._scratch = None
 
     def read(self, size=-1):
         data = self.pipe.read(size)
         self.pos += len(data)
         return data
 
+    def _skip(self, size):
+        if self._scratch is None:
+            self._scratch = memoryview(bytearray(SKIP_BUFFER_SIZE))
+
+        while size > 0:
+            n = self.pipe.readinto(self._scratch[:min(size, SKIP_BUFFER_SIZE)])
+            if not n:
+                break
+            self.pos += n
+            size -= n
+
     def seek(self, offset, whence=0):
         if whence == 0:
             to_read = offset - self.pos
             if to_read < 0:
                 raise IOError('Only forward seeking possible')
-            self.pos += len(self.pipe.read(to_read))
+            self._skip(to_read)
 
         if whence == 1:
             if offset < 0:
                 raise IOError('Only forward seeking possible')
-            self.pos += len(self.pipe.read(offset))
+            self._skip(offset)
 
         if whence == 2:
             raise IOError('Only forward seeking possible')
@@ -62,25 +106,277 @@ class PipeWrapper:
         return self.pos
 
 
+class MemoryMappedFile:
+    '''
+    Read-only, seekable file-like access to an uncompressed file
+    using a memory map.
+
+    `read` returns `bytes` like a normal file object,
+    `view` returns a `memoryview` into the mapping without copying the data.
+    '''
+    def __init__(self, path):
+        self._file = open(path, mode='rb')
+        try:
+            self._mmap = mmap.mmap(self._file.fileno(), 0, access=mmap.ACCESS_READ)
+        except Exception:
+            self._file.close()
+            raise
+        self._view = memoryview(self._mmap)
+        self.size = len(self._mmap)
+        self.pos = 0
+
+    def _stop(self, size):
+        if size is None or size < 0:
+            return self.size
+        return min(self.pos + size, self.size)
+
+    def read(self, size=-1):
+        data = self._mmap[self.pos:self._stop(size)]
+        self.pos += len(data)
+        return data
+
+    def view(self, size=-1):
+        '''Like `read`, but returns a `memoryview` into the mapped file'''
+        data = self._view[self.pos:self._stop(size)]
+        self.pos += len(data)
+        return data
+
+    def seek(self, offset, whence=0):
+        if whence == 0:
+            pos = offset
+        elif whence == 1:
+            pos = self.pos + offset
+        elif whence == 2:
+            pos = self.size + offset
+        else:
+            raise ValueError(
+                'invalid whence ({}, should be 0, 1 or 2)'.format(whence)
+            )
+
+        if pos < 0:
+            raise ValueError('negative seek position {}'.format(pos))
+
+        self.pos = pos
+        return self.pos
+
+    def tell(self):
+        return self.pos
+
+    @property
+    def buffer(self):
+        '''memoryview of the complete mapped file'''
+        return self._view
+
+    def close(self):
+        self._view.release()
+        try:
+            self._mmap.close()
+        except BufferError:
+            # arrays created with np.frombuffer on views of the mapping
+            # are still alive, the mapping is released once they are gone
+            log.debug('Memory map still in use, not closing it')
+        self._file.close()
+
+
+class OffsetBytesIO:
+    '''
+    Seekable file-like access to a part of a file already in memory.
+
+    Positions are the positions in the original file, so `EventIOObject`s
+    can be created with this as filehandle with their original headers.
+    `offset` is the position of the first byte of `data` in the original file.
+    '''
+    def __init__(self, data, offset=0):
+        self._view = memoryview(data)
+        self.offset = offset
+        self.size = offset + len(self._view)
+        self.pos = offset
+
+    def _slice(self, size):
+        start = max(self.pos - self.offset, 0)
+        if size is None or size < 0:
+            stop = len(self._view)
+        else:
+            stop = min(start + size, len(self._view))
+        return self._view[start:stop]
+
+    def read(self, size=-1):
+        data = self._slice(size).tobytes()
+        self.pos += len(data)
+        return data
+
+    def view(self, size=-1):
+        '''Like `read`, but returns a `memoryview` into `data`'''
+        data = self._slice(size)
+        self.pos += len(data)
+        return data
+
+    def seek(self, offset, whence=0):
+        if whence == 0:
+            pos = offset
+        elif whence == 1:
+            pos = self.pos + offset
+        elif whence == 2:
+            pos = self.size + offset
+        else:
+            raise ValueError(
+                'invalid whence ({}, should be 0, 1 or 2)'.format(whence)
+            )
+
+        if pos < self.offset:
+            raise ValueError(
+                'Position {} is in front of the data starting at {}'.format(
+                    pos, self.offset
+                )
+            )
+
+        self.pos = pos
+        return self.pos
+
+    def tell(self):
+        return self.pos
+
+    def close(self):
+        # views of the data might still be in use, so don't release it
+        self._view = None
+
+
+class ReadAheadReader(BlockReader):
+    '''
+    Forward-seekable file-like wrapper, that reads `raw` in blocks of
+    `block_size` bytes on a background thread, keeping up to `depth`
+    blocks ready.
+
+    This lets decompression (in a zcat subprocess or in the zstd and gzip
+    modules, which release the GIL) run concurrently with parsing.
+    '''
+    def __init__(self, raw, depth=4, block_size=DEFAULT_READ_AHEAD_BLOCK_SIZE):
+        if depth < 1:
+            raise ValueError('depth must be at least 1')
+        super().__init__()
+        self._raw = raw
+        self.depth = depth
+        self.block_size = block_size
+
+        self._queue = queue.Queue(maxsize=depth)
+        self._stop = threading.Event()
+        self._thread = threading.Thread(target=self._read_blocks, daemon=True)
+        self._thread.start()
+
+    def _put(self, item):
+        while not self._stop.is_set():
+            try:
+                self._queue.put(item, timeout=0.1)
+                return True
+            except queue.Full:
+                pass
+        return False
+
+    def _read_blocks(self):
+        try:
+            while not self._stop.is_set():
+                block = self._raw.read(self.block_size)
+                if not self._put(block) or not block:
+                    return
+        except Exception as e:
+            # raised in the consuming thread
+            self._put(e)
+
+    def _next_block(self):
+        block = self._queue.get()
+        if isinstance(block, Exception):
+            self._eof = True
+            raise block
+        return block
+
+    def close(self):
+        self._stop.set()
+        # unblock the reading thread, if it is waiting for space in the queue
+        while True:
+            try:
+                self._queue.get_nowait()
+            except queue.Empty:
+                break
+        self._thread.join()
+        self._raw.close()
+
+
 class EventIOFile:
 
-    def __init__(self, path, zcat=True):
+    def __init__(
+        self,
+        path,
+        zcat=True,
+        mmap=True,
+        seekable=False,
+        read_ahead=0,
+        read_ahead_block_size=DEFAULT_READ_AHEAD_BLOCK_SIZE,
+        decompression_threads=1,
+        instrumentation=False,
+    ):
+        '''
+        Parameters
+        ----------
+        path: str or ByteSource
+            Path to the eventio file, can be gzip or zstd compressed.
+            Can also be a url or a `ByteSource`, see `eventio.sources`.
+        zcat: bool
+            If True, decompress gzip files in a gzip subprocess
+        mmap: bool
+            If True, memory map uncompressed files
+        seekable: bool
+            If True, use checkpointing readers for compressed files,
+            that allow efficient seeking backwards,
+            see `eventio.compression`. Takes precedence over `zcat`.
+        read_ahead: int
+            For compressed files, that are not opened with `seekable`:
+            decompress up to this many blocks ahead on a background thread
+            and read each toplevel object completely into memory,
+            see `ReadAheadReader`. 0 (default) disables reading ahead.
+        read_ahead_block_size: int
+            Size of the blocks read on the background thread in bytes
+        decompression_threads: int
+            If larger than 1, multi-frame zstd files and BGZF gzip files
+            are decompressed on this many threads. Other gzip files are
+            decompressed using pigz or igzip if available and `zcat` is True.
+        instrumentation: bool or Instrumentation
+            If True or an `Instrumentation` instance, collect statistics
+            about the objects read from this file, see `eventio.instrumentation`.
+            The statistics are available as `self.instrumentation`.
+        '''
         log.info('Opening new file {}'.format(path))
+        if is_remote(path):
+            # reuse the size and start of the file for the file type checks
+            path = as_source(path)
         self.path = path
         self.read_process = None
         self.zstd = False
         self.next = None
 
+        if instrumentation is True:
+            instrumentation = Instrumentation()
+        self.instrumentation = instrumentation or None
+
         if not is_eventio(path):
             raise ValueError('File {} is not an eventio file'.format(path))
 
         if is_gzip(path):
             log.info('Found gzipped file')
-            if zcat:
+            if seekable:
+                log.info('Using checkpointed gzip reader')
+                self._filehandle = CheckpointedGzipReader(path)
+            elif decompression_threads > 1 and is_bgzf(path):
+                log.info('Using {} threads for BGZF file'.format(decompression_threads))
+                self._filehandle = ParallelFrameReader(
+                    path, iter_bgzf_blocks, decompress_gzip_member,
+                    n_threads=decompression_threads,
+                )
+            elif zcat and not is_remote(path):
                 try:
-                    log.info('Trying to read using zcat')
+                    command = gzip_command(decompression_threads)
+                    log.info('Trying to read using {}'.format(command[0]))
                     self.read_process = sp.Popen(
-                        ['gzip', '-cd', path], stdout=sp.PIPE, stderr=sp.PIPE
+                        command + [path], stdout=sp.PIPE, stderr=sp.PIPE
                     )
                     self.read_process.poll()
                     rc = self.read_process.returncode
@@ -95,7 +391,7 @@ class EventIOFile:
                     self._filehandle = gzip.open(path)
             else:
                 log.info('Using gzip module')
-                self._filehandle = gzip.open(path)
+                self._filehandle = gzip.open(open_binary(path) if is_remote(path) else path)
 
         elif is_zstd(path):
             log.info('Found zstd compressed file')
@@ -104,12 +400,42 @@ class EventIOFile:
                     'You need to install the `zstandard` module'
                     'to read zstd compressed file'
                 )
-            self._filehandle = zstd.ZstdDecompressor().stream_reader(open(path, 'rb'))
+            if seekable:
+                log.info('Using checkpointed zstd reader')
+                self._filehandle = CheckpointedZstdReader(path)
+            elif decompression_threads > 1 and is_multiframe_zstd(path):
+                log.info('Using {} threads for multi-frame zstd file'.format(
+                    decompression_threads
+                ))
+                self._filehandle = ParallelFrameReader(
+                    path, iter_zstd_frames, decompress_zstd_frame,
+                    n_threads=decompression_threads,
+                )
+            else:
+                self._filehandle = open_zstd_stream(path)
             self.zstd = True
 
         else:
             log.info('Found uncompressed file')
-            self._filehandle = open(path, mode='rb')
+            self._filehandle = None
+            if mmap and not is_remote(path):
+                try:
+                    self._filehandle = MemoryMappedFile(path)
+                    log.info('Using mmap')
+                except Exception as e:
+                    log.info(str(e))
+                    log.warning('Falling back to normal file access')
+
+            if self._filehandle is None:
+                self._filehandle = open_binary(path)
+
+        self._read_ahead = False
+        if read_ahead > 0 and not seekable and (is_gzip(path) or is_zstd(path)):
+            log.info('Reading ahead {} blocks on a background thread'.format(read_ahead))
+            self._filehandle = ReadAheadReader(
+                self._filehandle, depth=read_ahead, block_size=read_ahead_block_size,
+            )
+            self._read_ahead = True
 
         self._next_header_pos = 0
 
@@ -122,6 +448,9 @@ class EventIOFile:
             self.next = None
             return o
 
+        if self.instrumentation is not None:
+            start = perf_counter()
+
         self.seek(self._next_header_pos)
         read_sync_marker(self)
         header = read_header(
@@ -131,10 +460,23 @@ class EventIOFile:
         )
         self._next_header_pos += header.total_size
 
-        return KNOWN_OBJECTS.get(header.type, EventIOObject)(
+        filehandle = self._filehandle
+        if self._read_ahead:
+            # hand out the complete object, so parsing does not
+            # wait for the reader and can seek freely inside the object
+            filehandle = OffsetBytesIO(
+                self._filehandle.view(header.content_size),
+                header.content_address,
+            )
+
+        o = KNOWN_OBJECTS.get(header.type, EventIOObject)(
             header,
-            filehandle=self._filehandle,
+            filehandle=filehandle,
         )
+        if self.instrumentation is not None:
+            # includes skipping to the object and, with read ahead, reading it
+            self.instrumentation.record_object(o, perf_counter() - start)
+        return o
 
     def peek(self):
         if self.next is None:
@@ -147,6 +489,44 @@ class EventIOFile:
     def tell(self):
         return self._filehandle.tell()
 
+    def scan_objects(self, max_depth=0, payloads=None):
+        '''Build an index of the objects in this file by only reading the headers.
+
+        For memory mapped files, this runs completely in compiled code,
+        no python objects are created for the scanned objects.
+        Compressed files are opened a second time and decompressed once
+        in a pure python fallback, the state of this file is not modified.
+
+        Parameters
+        ----------
+        max_depth: int
+            Up to which nesting level subobjects are also indexed.
+            0 (default) only indexes toplevel objects, a negative value
+            indexes all levels.
+        payloads: dict or None
+            Only used for files scanned as stream, see `scan_stream`.
+            Memory mapped files do not need to collect payloads while scanning.
+
+        Returns
+        -------
+        index: np.ndarray[OBJECT_INDEX_DTYPE]
+            See `eventio.header.scan_objects`
+        end: int
+            Position after the last complete toplevel object
+        '''
+        if isinstance(self._filehandle, MemoryMappedFile):
+            return scan_objects(self._filehandle.buffer, max_depth=max_depth)
+
+        if is_remote(self.path) or is_gzip(self.path) or is_zstd(self.path):
+            with EventIOFile(self.path, mmap=False) as f:
+                return scan_stream(f._filehandle, max_depth=max_depth, payloads=payloads)
+
+        filehandle = MemoryMappedFile(self.path)
+        try:
+            return scan_objects(filehandle.buffer, max_depth=max_depth)
+        finally:
+            filehandle.close()
+
     def read(self, size=-1):
         return self._filehandle.read(size)
 
@@ -162,6 +542,18 @@ class EventIOFile:
             self.read_process.terminate()
 
 
+def open_zstd_stream(path):
+    '''Open a zstd stream reader, that reads all frames of the file'''
+    raw = open_binary(path)
+    dctx = zstd.ZstdDecompressor()
+    try:
+        # by default, the stream reader stops at the end of the first frame
+        return dctx.stream_reader(raw, read_across_frames=True)
+    except (TypeError, ValueError, NotImplementedError):
+        # older zstandard versions do not support reading across frames
+        return dctx.stream_reader(raw)
+
+
 def check_size_or_raise(data, expected_length, zero_ok=True):
     length = len(data)
     if length == 0:
@@ -218,6 +610,97 @@ def read_header(byte_stream, offset, toplevel=False):
     return header
 
 
+def _index_row(header, offset, depth):
+    return (
+        header.type,
+        header.version,
+        header.id,
+        offset,
+        header.content_size,
+        header.header_size,
+        header.only_subobjects,
+        depth,
+    )
+
+
+def scan_stream(byte_stream, max_depth=0, payloads=None):
+    '''Pure python version of `eventio.header.scan_objects`
+    working on forward-seekable file-like objects, e.g. decompressing streams.
+
+    `payloads` can map (type, depth) of objects to empty dicts. The payloads
+    of these objects are then read during the scan and stored in
+    these dicts by row number of the object in the index,
+    so a compressed file does not have to be decompressed a second time.
+    Since the stream is only read forward, these objects must not be
+    containers whose subobjects are scanned.
+    '''
+    rows = []
+    pos = 0
+    while True:
+        byte_stream.seek(pos)
+        try:
+            read_sync_marker(byte_stream)
+            header = read_header(byte_stream, offset=pos, toplevel=True)
+        except (StopIteration, EOFError):
+            break
+
+        first_row = len(rows)
+        end = pos + header.total_size
+        rows.append(_index_row(header, pos, 0))
+        _collect_payload(byte_stream, header, 0, first_row, payloads)
+
+        if header.only_subobjects and max_depth != 0:
+            _scan_stream_subobjects(
+                byte_stream, rows, header.content_address, end, 1, max_depth, payloads,
+            )
+
+        # seek returns the actual position, which is smaller
+        # than requested for truncated files
+        if byte_stream.seek(end) < end:
+            del rows[first_row:]
+            break
+        pos = end
+
+    if payloads is not None:
+        # remove payloads of the truncated last object
+        for collected in payloads.values():
+            for row in [row for row in collected if row >= len(rows)]:
+                del collected[row]
+
+    return np.array(rows, dtype=OBJECT_INDEX_DTYPE), pos
+
+
+def _collect_payload(byte_stream, header, depth, row, payloads):
+    if payloads is None:
+        return
+    collected = payloads.get((header.type, depth))
+    if collected is not None:
+        # the stream is at the start of the payload after reading the header
+        collected[row] = byte_stream.read(header.content_size)
+
+
+def _scan_stream_subobjects(byte_stream, rows, pos, end, depth, max_depth, payloads=None):
+    while pos < end:
+        byte_stream.seek(pos)
+        try:
+            header = read_header(byte_stream, offset=pos, toplevel=False)
+        except (StopIteration, EOFError):
+            break
+
+        object_end = pos + header.total_size
+        if object_end > end:
+            break
+
+        rows.append(_index_row(header, pos, depth))
+        _collect_payload(byte_stream, header, depth, len(rows) - 1, payloads)
+        if header.only_subobjects and (max_depth < 0 or depth < max_depth):
+            _scan_stream_subobjects(
+                byte_stream, rows, header.content_address, object_end,
+                depth + 1, max_depth, payloads,
+            )
+        pos = object_end
+
+
 def check_sync_bytes(sync):
     ''' returns the endianness as given by the sync byte '''
 
@@ -252,17 +735,39 @@ class EventIOObject:
     '''
     eventio_type = None
 
+    # millions of (sub)objects are created when iterating large files,
+    # so objects have no instance dict. Subclasses used for frequent
+    # objects should also define (possibly empty) `__slots__` and prefer
+    # properties computed from the header over attributes set in `__init__`.
+    # Subclasses without `__slots__` work as before.
+    __slots__ = (
+        '_filehandle', 'header', 'address', 'size', 'only_subobjects',
+        '_next_header_pos', '_pos',
+        # set by an instrumented file, see `eventio.instrumentation`
+        '_instrumentation',
+    )
+
+    # objects of the same type and version, that are parsed differently,
+    # can return a string here to be instrumented separately
+    instrumentation_variant = None
+
+    def __init_subclass__(cls, **kwargs):
+        super().__init_subclass__(**kwargs)
+        if 'parse' in cls.__dict__:
+            cls.parse = timed_parse(cls.parse)
+
     def __init__(self, header, filehandle):
         if self.eventio_type is not None and header.type != self.eventio_type:
             raise WrongType(self.eventio_type, header.type)
 
         self._filehandle = filehandle
         self.header = header
-        self.address = self.header.content_address
-        self.size = self.header.content_size
-        self.only_subobjects = self.header.only_subobjects
+        self.address = header.content_address
+        self.size = header.content_size
+        self.only_subobjects = header.only_subobjects
         self._next_header_pos = 0
         self._pos = 0
+        self._instrumentation = None
 
     def read(self, size=-1):
         '''Read bytes from the payload of this object.
@@ -278,11 +783,41 @@ class EventIOObject:
         if size == -1 or size > remaining:
             size = remaining
 
-        data = self._filehandle.read(size)
+        if self._instrumentation is not None:
+            start = perf_counter()
+            data = self._filehandle.read(size)
+            self._instrumentation.record_io(self, perf_counter() - start)
+        else:
+            data = self._filehandle.read(size)
         self._pos += len(data)
 
         return data
 
+    def view(self, size=-1):
+        '''Like `read`, but returns a `memoryview`.
+
+        If the file is memory mapped, the view points directly into the
+        mapping and no data is copied.
+        '''
+        remaining = self.size - self._pos
+        if size == -1 or size > remaining:
+            size = remaining
+
+        if self._instrumentation is not None:
+            start = perf_counter()
+
+        view = getattr(self._filehandle, 'view', None)
+        if view is not None:
+            data = view(size)
+        else:
+            data = memoryview(self._filehandle.read(size))
+        self._pos += len(data)
+
+        if self._instrumentation is not None:
+            self._instrumentation.record_io(self, perf_counter() - start)
+
+        return data
+
     def __iter__(self):
         if not self.header.only_subobjects:
             raise ValueError(
@@ -291,6 +826,16 @@ class EventIOObject:
         return self
 
     def __next__(self):
+        return self.object_from_header(self.next_header())
+
+    def next_header(self):
+        '''Read the header of the next subobject and move on to the one after it,
+        without creating an `EventIOObject` or reading the payload.
+
+        Allows to skip subobjects only based on their header,
+        use `object_from_header` to create the object for a header.
+        Raises StopIteration after the last subobject.
+        '''
         if not self.only_subobjects:
             raise ValueError(
                 'Only EventIOObjects that contain just subobjects are iterable'
@@ -306,10 +851,16 @@ class EventIOObject:
             offset=self.address + self._next_header_pos,
         )
         self._next_header_pos += header.total_size
+        return header
 
-        return KNOWN_OBJECTS.get(header.type, EventIOObject)(
+    def object_from_header(self, header):
+        '''Create the `EventIOObject` for a header returned by `next_header`'''
+        o = KNOWN_OBJECTS.get(header.type, EventIOObject)(
             header, filehandle=self._filehandle
         )
+        if self._instrumentation is not None:
+            self._instrumentation.record_object(o)
+        return o
 
     def seek(self, offset, whence=0):
         address = self.address
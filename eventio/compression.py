@@ -0,0 +1,643 @@
+'''
+Seekable readers for compressed eventio files.
+
+Decompression can only start at certain points of a compressed stream.
+The readers in this module remember such points ("checkpoints") while
+reading, so seeking backwards restarts decompression at the nearest
+checkpoint in front of the target instead of at the start of the file.
+'''
+from bisect import bisect_right
+from collections import deque
+from concurrent.futures import ThreadPoolExecutor
+import shutil
+import struct
+import zlib
+
+from .sources import open_binary
+
+try:
+    import zstandard as zstd
+    has_zstd = True
+except ImportError:
+    has_zstd = False
+
+
+DEFAULT_CHECKPOINT_SPACING = 8 * 1024**2
+CHUNK_SIZE = 128 * 1024
+
+ZSTD_MAGIC = 0xFD2FB528
+ZSTD_SKIPPABLE_MAGIC_MIN = 0x184D2A50
+ZSTD_SKIPPABLE_MAGIC_MAX = 0x184D2A5F
+
+# zstd seekable format, the seek table is stored in a skippable frame
+# at the end of the file, see
+# https://github.com/facebook/zstd/blob/dev/contrib/seekable_format/zstd_seekable_compression_format.md
+ZSTD_SEEK_TABLE_MAGIC = 0x184D2A5E
+ZSTD_SEEKABLE_MAGIC = 0x8F92EAB1
+ZSTD_SEEK_TABLE_FOOTER = struct.Struct('<IBI')
+
+
+class CheckpointedReader:
+    '''
+    Base class for the checkpointed readers.
+
+    Subclasses implement `_fill`, which decompresses the next chunk
+    of data into `self._buffer` and adds checkpoints,
+    and `_restore`, which restarts decompression at a checkpoint.
+
+    Checkpoints are tuples, with the uncompressed offset as first element.
+    '''
+    def __init__(self, path, checkpoint_spacing=DEFAULT_CHECKPOINT_SPACING):
+        self.path = path
+        self.checkpoint_spacing = checkpoint_spacing
+        self._raw = open_binary(path)
+        self._checkpoints = []
+        self._restore(None)
+
+    def _reset_buffer(self, position):
+        # position of the next byte returned by read
+        self._pos = position
+        # uncompressed position of the end of the decompressed data
+        self._decompressed = position
+        self._buffer = b''
+        self._offset = 0
+
+    def _needs_checkpoint(self, position):
+        if not self._checkpoints:
+            return position >= self.checkpoint_spacing
+        last = self._checkpoints[-1][0]
+        return position > last and position >= last + self.checkpoint_spacing
+
+    def _fill(self, target=None):
+        raise NotImplementedError
+
+    def _restore(self, checkpoint):
+        raise NotImplementedError
+
+    @property
+    def checkpoints(self):
+        '''uncompressed offsets of the known checkpoints'''
+        return [c[0] for c in self._checkpoints]
+
+    def read(self, size=-1):
+        parts = []
+        remaining = size if size is not None and size >= 0 else float('inf')
+
+        while remaining > 0:
+            if self._offset >= len(self._buffer):
+                if not self._fill():
+                    break
+                continue
+
+            end = len(self._buffer)
+            if remaining < end - self._offset:
+                end = self._offset + remaining
+            chunk = self._buffer[self._offset:end]
+            self._offset = end
+            remaining -= len(chunk)
+            parts.append(chunk)
+
+        data = b''.join(parts)
+        self._pos += len(data)
+        return data
+
+    def _skip_to(self, target):
+        while self._pos < target:
+            available = len(self._buffer) - self._offset
+            if available == 0:
+                if not self._fill(target):
+                    break
+                # _fill might have skipped data without decompressing it
+                self._pos = self._decompressed - len(self._buffer)
+                continue
+
+            n = min(available, target - self._pos)
+            self._offset += n
+            self._pos += n
+
+    def seek(self, offset, whence=0):
+        if whence == 0:
+            target = offset
+        elif whence == 1:
+            target = self._pos + offset
+        elif whence == 2:
+            self._skip_to(float('inf'))
+            target = self._pos + offset
+        else:
+            raise ValueError(
+                'invalid whence ({}, should be 0, 1 or 2)'.format(whence)
+            )
+
+        if target < 0:
+            raise ValueError('negative seek position {}'.format(target))
+
+        if target < self._pos or target - self._pos > self.checkpoint_spacing:
+            idx = bisect_right(self.checkpoints, target) - 1
+            checkpoint = self._checkpoints[idx] if idx >= 0 else None
+            checkpoint_pos = checkpoint[0] if checkpoint is not None else 0
+
+            if target < self._pos or checkpoint_pos > self._pos:
+                self._restore(checkpoint)
+
+        self._skip_to(target)
+        return self._pos
+
+    def tell(self):
+        return self._pos
+
+    def close(self):
+        self._raw.close()
+
+
+class CheckpointedGzipReader(CheckpointedReader):
+    '''
+    Seekable reader for gzip files, works similar to zran.c of zlib:
+    every `checkpoint_spacing` uncompressed bytes, the complete state of
+    the decompressor is stored.
+    Multi-member files (e.g. concatenated gzip files) are supported.
+    '''
+    def _restore(self, checkpoint):
+        if checkpoint is None:
+            position, raw_position = 0, 0
+            self._decompressor = zlib.decompressobj(wbits=31)
+        else:
+            position, raw_position, decompressor = checkpoint
+            # the stored state must stay untouched for later restores
+            self._decompressor = decompressor.copy()
+
+        self._raw.seek(raw_position)
+        self._reset_buffer(position)
+
+    def _fill(self, target=None):
+        if not self._decompressor.eof and self._needs_checkpoint(self._decompressed):
+            self._checkpoints.append((
+                self._decompressed, self._raw.tell(), self._decompressor.copy()
+            ))
+
+        while True:
+            data = self._raw.read(CHUNK_SIZE)
+            if not data:
+                return False
+
+            out = self._decompressor.decompress(data)
+            while self._decompressor.eof and self._decompressor.unused_data:
+                # start of the next gzip member
+                unused_data = self._decompressor.unused_data
+                self._decompressor = zlib.decompressobj(wbits=31)
+                out += self._decompressor.decompress(unused_data)
+
+            if out:
+                self._buffer = out
+                self._offset = 0
+                self._decompressed += len(out)
+                return True
+
+
+def read_zstd_frame_sizes(f):
+    '''Determine size of the zstd frame starting at the current position of
+    `f` without decompressing it.
+
+    Returns the compressed size of the frame, the uncompressed content size
+    (None if not stored in the frame header) and whether it is a skippable frame.
+    The position of `f` is undefined afterwards.
+    '''
+    start = f.tell()
+    magic = int.from_bytes(f.read(4), 'little')
+
+    if ZSTD_SKIPPABLE_MAGIC_MIN <= magic <= ZSTD_SKIPPABLE_MAGIC_MAX:
+        size = int.from_bytes(f.read(4), 'little')
+        return 8 + size, 0, True
+
+    if magic != ZSTD_MAGIC:
+        raise IOError('Invalid zstd frame at position {}'.format(start))
+
+    descriptor = f.read(1)[0]
+    content_size_flag = descriptor >> 6
+    single_segment = (descriptor >> 5) & 1
+    has_checksum = (descriptor >> 2) & 1
+    dictionary_id_size = (0, 1, 2, 4)[descriptor & 3]
+    content_size_size = (single_segment, 2, 4, 8)[content_size_flag]
+
+    f.seek((0 if single_segment else 1) + dictionary_id_size, 1)
+    content_size = None
+    if content_size_size > 0:
+        content_size = int.from_bytes(f.read(content_size_size), 'little')
+        if content_size_size == 2:
+            content_size += 256
+
+    position = f.tell()
+    while True:
+        block_header = f.read(3)
+        if len(block_header) < 3:
+            # truncated, the frame ends where the file ends
+            return position - start, None, False
+
+        block_header = int.from_bytes(block_header, 'little')
+        last_block = block_header & 1
+        block_type = (block_header >> 1) & 3
+        block_size = block_header >> 3
+        if block_type == 3:
+            raise IOError('Invalid zstd block at position {}'.format(position))
+
+        # RLE blocks store only a single byte
+        position += 3 + (1 if block_type == 1 else block_size)
+        f.seek(position)
+        if last_block:
+            break
+
+    if has_checksum:
+        position += 4
+
+    return position - start, content_size, False
+
+
+def read_zstd_seek_table(f):
+    '''Read the seek table of a zstd file in the seekable format.
+
+    Returns a list with a tuple (compressed offset, uncompressed offset,
+    compressed size, uncompressed size) for each data frame
+    or None, if the file has no valid seek table.
+    The position of `f` is undefined afterwards.
+    '''
+    end = f.seek(0, 2)
+    if end < 8 + ZSTD_SEEK_TABLE_FOOTER.size:
+        return None
+
+    f.seek(end - ZSTD_SEEK_TABLE_FOOTER.size)
+    n_frames, descriptor, magic = ZSTD_SEEK_TABLE_FOOTER.unpack(
+        f.read(ZSTD_SEEK_TABLE_FOOTER.size)
+    )
+    if magic != ZSTD_SEEKABLE_MAGIC:
+        return None
+
+    # entries contain a checksum if the highest bit is set
+    entry_size = 12 if descriptor & 0x80 else 8
+    table_size = 8 + n_frames * entry_size + ZSTD_SEEK_TABLE_FOOTER.size
+    if table_size > end:
+        return None
+
+    f.seek(end - table_size)
+    magic, frame_size = struct.unpack('<II', f.read(8))
+    if magic != ZSTD_SEEK_TABLE_MAGIC or frame_size != table_size - 8:
+        return None
+
+    entries = f.read(n_frames * entry_size)
+    frames = []
+    compressed_offset = 0
+    uncompressed_offset = 0
+    for i in range(n_frames):
+        compressed_size, uncompressed_size = struct.unpack_from(
+            '<II', entries, i * entry_size
+        )
+        frames.append((
+            compressed_offset, uncompressed_offset,
+            compressed_size, uncompressed_size,
+        ))
+        compressed_offset += compressed_size
+        uncompressed_offset += uncompressed_size
+
+    # the table has to describe all data before it
+    if compressed_offset != end - table_size:
+        return None
+
+    return frames
+
+
+class CheckpointedZstdReader(CheckpointedReader):
+    '''
+    Seekable reader for zstd files.
+
+    zstd frames are independent, so the start of each frame is a checkpoint.
+    Frames, for which the uncompressed size is stored in the header,
+    are skipped without decompression when seeking forward.
+
+    Files in the zstd seekable format, e.g. written by `eventio.writer.EventIOWriter`,
+    contain a seek table with the positions of all frames,
+    which are used as checkpoints right from the start.
+
+    Note that files written by the zstd command line tool contain a single frame,
+    so seeking backwards in those restarts at the beginning of the file.
+    '''
+    def __init__(self, path, checkpoint_spacing=0):
+        if not has_zstd:
+            raise IOError(
+                'You need to install the `zstandard` module '
+                'to read zstd compressed files'
+            )
+        self._dctx = zstd.ZstdDecompressor()
+        super().__init__(path, checkpoint_spacing=checkpoint_spacing)
+
+        seek_table = read_zstd_seek_table(self._raw)
+        if seek_table is not None:
+            self._checkpoints = [
+                (uncompressed_offset, compressed_offset)
+                for compressed_offset, uncompressed_offset, _, _ in seek_table
+            ]
+        self._restore(None)
+
+    def _restore(self, checkpoint):
+        if checkpoint is None:
+            position, raw_position = 0, 0
+        else:
+            position, raw_position = checkpoint
+
+        self._raw.seek(raw_position)
+        self._frame_remaining = 0
+        self._decompressor = None
+        self._reset_buffer(position)
+
+    def _start_frame(self, target=None):
+        raw_position = self._raw.tell()
+        if not self._raw.read(1):
+            return False
+        self._raw.seek(raw_position)
+
+        compressed_size, content_size, skippable = read_zstd_frame_sizes(self._raw)
+        if skippable:
+            self._raw.seek(raw_position + compressed_size)
+            return True
+
+        if self._needs_checkpoint(self._decompressed):
+            self._checkpoints.append((self._decompressed, raw_position))
+
+        if (
+            target is not None
+            and content_size is not None
+            and self._decompressed + content_size <= target
+        ):
+            self._raw.seek(raw_position + compressed_size)
+            self._decompressed += content_size
+            self._buffer = b''
+            self._offset = 0
+            return True
+
+        self._raw.seek(raw_position)
+        self._frame_remaining = compressed_size
+        self._decompressor = self._dctx.decompressobj()
+        return True
+
+    def _fill(self, target=None):
+        while True:
+            if self._frame_remaining == 0:
+                decompressed = self._decompressed
+                if not self._start_frame(target):
+                    return False
+                if self._decompressed != decompressed:
+                    # frame skipped completely
+                    return True
+                continue
+
+            data = self._raw.read(min(CHUNK_SIZE, self._frame_remaining))
+            if not data:
+                return False
+            self._frame_remaining -= len(data)
+
+            out = self._decompressor.decompress(data)
+            if out:
+                self._buffer = out
+                self._offset = 0
+                self._decompressed += len(out)
+                return True
+
+
+def iter_zstd_frames(f):
+    '''Yield offset and compressed size of all
+    non-skippable frames in the zstd file `f`.
+    If the file has a seek table, it is used instead of reading the frame headers.
+    '''
+    seek_table = read_zstd_seek_table(f)
+    if seek_table is not None:
+        for compressed_offset, _, compressed_size, _ in seek_table:
+            yield compressed_offset, compressed_size
+        return
+
+    end = f.seek(0, 2)
+    position = 0
+    while position < end:
+        f.seek(position)
+        compressed_size, _, skippable = read_zstd_frame_sizes(f)
+        if not skippable:
+            yield position, compressed_size
+        position += compressed_size
+
+
+def is_multiframe_zstd(path):
+    '''True if the zstd file at `path` contains more than one data frame'''
+    with open_binary(path) as f:
+        frames = iter_zstd_frames(f)
+        return next(frames, None) is not None and next(frames, None) is not None
+
+
+def _bgzf_block_size(header):
+    '''Size of the BGZF block from the gzip member header without the extra field,
+    None if this is not a BGZF block'''
+    # the extra field of BGZF contains a subfield "BC" with the block size - 1
+    extra = header[12:]
+    pos = 0
+    while pos + 4 <= len(extra):
+        subfield_length = int.from_bytes(extra[pos + 2:pos + 4], 'little')
+        if extra[pos:pos + 2] == b'BC' and subfield_length == 2:
+            return int.from_bytes(extra[pos + 4:pos + 6], 'little') + 1
+        pos += 4 + subfield_length
+    return None
+
+
+def _read_bgzf_header(f):
+    header = f.read(12)
+    # magic bytes, deflate compression and only the FEXTRA flag
+    if len(header) < 12 or header[:4] != b'\x1f\x8b\x08\x04':
+        return None
+    extra_length = int.from_bytes(header[10:12], 'little')
+    return header + f.read(extra_length)
+
+
+def iter_bgzf_blocks(f):
+    '''Yield offset and compressed size of the blocks of the BGZF file `f`'''
+    end = f.seek(0, 2)
+    position = 0
+    while position < end:
+        f.seek(position)
+        header = _read_bgzf_header(f)
+        size = _bgzf_block_size(header) if header is not None else None
+        if size is None:
+            raise IOError('Invalid BGZF block at position {}'.format(position))
+        yield position, size
+        position += size
+
+
+def is_bgzf(path):
+    '''True if the gzip file at `path` is made of BGZF blocks,
+    i.e. gzip members that store their compressed size in the header'''
+    with open_binary(path) as f:
+        header = _read_bgzf_header(f)
+    return header is not None and _bgzf_block_size(header) is not None
+
+
+def decompress_gzip_member(data):
+    return zlib.decompress(data, wbits=31)
+
+
+def decompress_zstd_frame(data):
+    # decompressors can not be shared between threads
+    return zstd.ZstdDecompressor().decompressobj().decompress(data)
+
+
+class BlockReader:
+    '''
+    Base class for forward-seekable readers, that get their data
+    in blocks of decompressed bytes from `_next_block`, which returns
+    the next block or an empty bytes object at the end of the data.
+    '''
+    def __init__(self):
+        self.pos = 0
+        self._block = b''
+        self._offset = 0
+        self._eof = False
+
+    def _next_block(self):
+        raise NotImplementedError
+
+    def _advance(self):
+        if self._eof:
+            return False
+
+        block = self._next_block()
+        if not block:
+            self._eof = True
+            return False
+
+        self._block = block
+        self._offset = 0
+        return True
+
+    def _available(self):
+        return len(self._block) - self._offset
+
+    def _read(self, size, as_view):
+        if size is None or size < 0:
+            size = float('inf')
+
+        # fast path: the data is completely inside the current block
+        if 0 < size <= self._available():
+            start = self._offset
+            self._offset += size
+            self.pos += size
+            if as_view:
+                return memoryview(self._block)[start:self._offset]
+            return self._block[start:self._offset]
+
+        parts = []
+        remaining = size
+        while remaining > 0:
+            if self._available() == 0 and not self._advance():
+                break
+            n = min(remaining, self._available())
+            parts.append(self._block[self._offset:self._offset + n])
+            self._offset += n
+            remaining -= n
+
+        data = b''.join(parts)
+        self.pos += len(data)
+        return memoryview(data) if as_view else data
+
+    def read(self, size=-1):
+        return self._read(size, as_view=False)
+
+    def view(self, size=-1):
+        '''Like `read`, but returns a memoryview, avoiding a copy if the
+        data is inside a single block'''
+        return self._read(size, as_view=True)
+
+    def seek(self, offset, whence=0):
+        if whence == 0:
+            to_skip = offset - self.pos
+        elif whence == 1:
+            to_skip = offset
+        else:
+            raise IOError('Only forward seeking possible')
+
+        if to_skip < 0:
+            raise IOError('Only forward seeking possible')
+
+        while to_skip > 0:
+            if self._available() == 0 and not self._advance():
+                break
+            n = min(to_skip, self._available())
+            self._offset += n
+            self.pos += n
+            to_skip -= n
+
+        return self.pos
+
+    def tell(self):
+        return self.pos
+
+
+class ParallelFrameReader(BlockReader):
+    '''
+    Forward-seekable reader for compressed files made of independent frames,
+    like multi-frame zstd or BGZF files, decompressing several frames
+    at once on a thread pool.
+
+    Parameters
+    ----------
+    path: str
+        The compressed file
+    iter_frames: callable
+        Called with the open file, yields (offset, compressed size) for each frame,
+        e.g. `iter_zstd_frames` or `iter_bgzf_blocks`
+    decompress: callable
+        Decompresses the bytes of a single frame,
+        e.g. `decompress_zstd_frame` or `decompress_gzip_member`
+    n_threads: int
+        Number of decompression threads
+    '''
+    def __init__(self, path, iter_frames, decompress, n_threads=4):
+        super().__init__()
+        self.path = path
+        self._raw = open_binary(path)
+        self._frames = iter_frames(self._raw)
+        self._decompress = decompress
+        self._executor = ThreadPoolExecutor(max_workers=n_threads)
+        self._pending = deque()
+        self._max_pending = 2 * n_threads
+
+    def _submit(self):
+        while len(self._pending) < self._max_pending:
+            frame = next(self._frames, None)
+            if frame is None:
+                return
+            offset, size = frame
+            self._raw.seek(offset)
+            data = self._raw.read(size)
+            self._pending.append(self._executor.submit(self._decompress, data))
+
+    def _next_block(self):
+        self._submit()
+        while self._pending:
+            block = self._pending.popleft().result()
+            self._submit()
+            if block:
+                return block
+        return b''
+
+    def close(self):
+        for future in self._pending:
+            future.cancel()
+        self._pending.clear()
+        self._executor.shutdown(wait=True)
+        self._raw.close()
+
+
+def gzip_command(n_threads=1):
+    '''Command to decompress a gzip file to stdout.
+    For n_threads > 1, pigz or igzip are used if they are installed,
+    otherwise gzip. igzip is single threaded for decompression,
+    but still much faster than gzip.
+    '''
+    if n_threads > 1:
+        if shutil.which('pigz') is not None:
+            return ['pigz', '-dc', '-p', str(n_threads)]
+        if shutil.which('igzip') is not None:
+            return ['igzip', '-dc']
+    return ['gzip', '-cd']
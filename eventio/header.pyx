@@ -1,6 +1,11 @@
 # cython: language_level=3
 import cython
-from libc.stdint cimport uint8_t, uint32_t, uint64_t
+import numpy as np
+cimport numpy as cnp
+from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t, int64_t
+from libc.string cimport memcpy
+
+cnp.import_array()
 
 
 # cython's way to declare constants
@@ -31,8 +36,14 @@ cdef enum:
     EXTENSION_N_BITS = 12
     EXTENSION_POS = 0
 
+    SYNC_MARKER_LITTLE_ENDIAN = 0xD41F8A37
+    SYNC_MARKER_BIG_ENDIAN = 0x378A1FD4
+
 
 
+# headers are created and freed for every visited (sub)object,
+# keep the memory of freed headers around for reuse
+@cython.freelist(64)
 cdef class ObjectHeader:
     cdef readonly uint32_t id
     cdef readonly uint32_t type
@@ -48,6 +59,20 @@ cdef class ObjectHeader:
     def total_size(self):
         return self.content_size + self.header_size
 
+    def __reduce__(self):
+        # needed to send headers to other processes
+        return (rebuild_object_header, (
+            self.id,
+            self.type,
+            self.version,
+            self.user,
+            self.extended,
+            self.only_subobjects,
+            self.header_size,
+            self.content_address,
+            self.content_size,
+        ))
+
     def __repr__(self):
         return (
             'Header[{}]('.format(self.type)
@@ -62,6 +87,23 @@ cdef class ObjectHeader:
         )
 
 
+def rebuild_object_header(
+    id_, type_, version, user, extended, only_subobjects,
+    header_size, content_address, content_size,
+):
+    cdef ObjectHeader header = ObjectHeader()
+    header.id = id_
+    header.type = type_
+    header.version = version
+    header.user = user
+    header.extended = extended
+    header.only_subobjects = only_subobjects
+    header.header_size = header_size
+    header.content_address = content_address
+    header.content_size = content_size
+    return header
+
+
 cpdef bint bool_bit_from_pos(uint32_t uint32_word, uint32_t pos):
     '''parse a Python Boolean from a bit a position `pos` in an
     unsigned 32bit integer.
@@ -143,3 +185,234 @@ cpdef ObjectHeader parse_header_bytes(const uint8_t[:] header_bytes, bint toplev
         header.header_size += EXTENSION_SIZE
 
     return header
+
+
+# One row of the object index created by `scan_objects`
+# offset is the position of the first byte of the object, including
+# the sync marker for toplevel objects, size is the size of the content.
+# So the content starts at offset + header_size.
+OBJECT_INDEX_DTYPE = np.dtype([
+    ('type', 'u4'),
+    ('version', 'u2'),
+    ('id', 'u4'),
+    ('offset', 'u8'),
+    ('size', 'u8'),
+    ('header_size', 'u1'),
+    ('only_subobjects', 'u1'),
+    ('depth', 'u1'),
+])
+
+
+# memory layout of one row of OBJECT_INDEX_DTYPE
+cdef packed struct ObjectIndexEntry:
+    uint32_t type
+    uint16_t version
+    uint32_t id
+    uint64_t offset
+    uint64_t size
+    uint8_t header_size
+    uint8_t only_subobjects
+    uint8_t depth
+
+
+assert OBJECT_INDEX_DTYPE.itemsize == sizeof(ObjectIndexEntry)
+
+
+cdef inline uint32_t read_uint32(const uint8_t* ptr) nogil:
+    cdef uint32_t value
+    memcpy(&value, ptr, 4)
+    return value
+
+
+cdef class ObjectIndexBuilder:
+    '''Growing array of ObjectIndexEntry, backed by a numpy array'''
+    cdef cnp.ndarray entries
+    cdef ObjectIndexEntry* ptr
+    cdef uint64_t capacity
+    cdef uint64_t n_entries
+
+    def __cinit__(self, uint64_t capacity=1024):
+        if capacity == 0:
+            capacity = 1
+        self.entries = np.empty(capacity, dtype=OBJECT_INDEX_DTYPE)
+        self.ptr = <ObjectIndexEntry*> cnp.PyArray_DATA(self.entries)
+        self.capacity = capacity
+        self.n_entries = 0
+
+    cdef ObjectIndexEntry* append(self) except NULL:
+        cdef cnp.ndarray new_entries
+        if self.n_entries == self.capacity:
+            new_entries = np.empty(2 * self.capacity, dtype=OBJECT_INDEX_DTYPE)
+            memcpy(
+                cnp.PyArray_DATA(new_entries),
+                self.ptr,
+                self.n_entries * sizeof(ObjectIndexEntry),
+            )
+            self.entries = new_entries
+            self.ptr = <ObjectIndexEntry*> cnp.PyArray_DATA(self.entries)
+            self.capacity *= 2
+
+        self.n_entries += 1
+        return &self.ptr[self.n_entries - 1]
+
+    cdef result(self):
+        return self.entries[:self.n_entries].copy()
+
+
+cdef int64_t fill_entry(
+    ObjectIndexEntry* entry,
+    const uint8_t* data,
+    uint64_t pos,
+    uint64_t end,
+    bint toplevel,
+):
+    '''Parse the header starting at data[pos] into entry.
+    Returns the total size of the object or -1 if
+    there are not enough bytes left before `end` for the complete object.
+    '''
+    cdef uint32_t type_word, length_word
+    cdef uint64_t header_pos = pos
+    cdef uint64_t header_size = OBJECT_HEADER_SIZE
+    cdef uint64_t content_size
+
+    if toplevel:
+        header_size += SYNC_MARKER_SIZE
+        header_pos += SYNC_MARKER_SIZE
+
+    if pos + header_size > end:
+        return -1
+
+    type_word = read_uint32(data + header_pos)
+    length_word = read_uint32(data + header_pos + 8)
+    content_size = get_bits_from_word(length_word, LENGTH_N_BITS, LENGTH_POS)
+
+    if bool_bit_from_pos(type_word, EXTENDED_POS):
+        header_size += EXTENSION_SIZE
+        if pos + header_size > end:
+            return -1
+        content_size |= (<uint64_t> get_bits_from_word(
+            read_uint32(data + header_pos + OBJECT_HEADER_SIZE),
+            EXTENSION_N_BITS,
+            EXTENSION_POS,
+        )) << LENGTH_N_BITS
+
+    if pos + header_size + content_size > end:
+        return -1
+
+    entry.type = get_bits_from_word(type_word, TYPE_N_BITS, TYPE_POS)
+    entry.version = get_bits_from_word(type_word, VERSION_N_BITS, VERSION_POS)
+    entry.id = read_uint32(data + header_pos + 4)
+    entry.offset = pos
+    entry.size = content_size
+    entry.header_size = header_size
+    entry.only_subobjects = bool_bit_from_pos(length_word, ONLY_SUBOBJECTS_POS)
+    entry.depth = 0
+
+    return header_size + content_size
+
+
+cdef int scan_subobjects(
+    ObjectIndexBuilder builder,
+    const uint8_t* data,
+    uint64_t pos,
+    uint64_t end,
+    int depth,
+    int max_depth,
+) except -1:
+    cdef ObjectIndexEntry* entry
+    cdef int64_t total_size
+    cdef uint8_t only_subobjects
+    cdef uint64_t content_start, content_end
+
+    while pos < end:
+        entry = builder.append()
+        total_size = fill_entry(entry, data, pos, end, False)
+        if total_size < 0:
+            # incomplete object, drop it
+            builder.n_entries -= 1
+            break
+
+        entry.depth = depth
+        only_subobjects = entry.only_subobjects
+        content_start = pos + entry.header_size
+        content_end = pos + total_size
+        pos += total_size
+
+        # entry might be invalidated by a resize of the builder
+        if only_subobjects and (max_depth < 0 or depth < max_depth):
+            scan_subobjects(
+                builder, data, content_start, content_end, depth + 1, max_depth
+            )
+
+    return 0
+
+
+def scan_objects(const uint8_t[::1] data, uint64_t offset=0, int max_depth=0):
+    '''Scan the headers of all toplevel objects in `data`, starting at `offset`,
+    without constructing python objects.
+
+    Parameters
+    ----------
+    data: bytes-like
+        The (uncompressed) file content, e.g. a memoryview of a memory map
+    offset: int
+        Position of the first toplevel object in data
+    max_depth: int
+        Up to which nesting level subobjects are also indexed.
+        0 (default) only indexes toplevel objects, a negative value
+        indexes all levels.
+
+    Returns
+    -------
+    index: np.ndarray[OBJECT_INDEX_DTYPE]
+        One row per object, in the order they appear in the file,
+        subobjects follow directly their parent object
+    end: int
+        Position after the last complete toplevel object.
+        If this is smaller than len(data), the file is truncated.
+    '''
+    cdef uint64_t n_bytes = data.shape[0]
+    cdef uint64_t pos = offset
+    cdef uint32_t sync
+    cdef int64_t total_size
+    cdef uint8_t only_subobjects
+    cdef uint64_t content_start, content_end
+    cdef ObjectIndexEntry* entry
+    cdef const uint8_t* ptr
+
+    # rough estimate assuming large objects, the builder grows if needed
+    cdef ObjectIndexBuilder builder = ObjectIndexBuilder(n_bytes // 4096 + 16)
+
+    if n_bytes == 0:
+        return builder.result(), 0
+
+    ptr = &data[0]
+
+    while pos + SYNC_MARKER_SIZE <= n_bytes:
+        sync = read_uint32(ptr + pos)
+        if sync != SYNC_MARKER_LITTLE_ENDIAN:
+            if sync == SYNC_MARKER_BIG_ENDIAN:
+                raise NotImplementedError(
+                    'Big endian byte order is not supported by this reader'
+                )
+            raise ValueError(
+                'Sync must be 0xD41F8A37 or 0x378A1FD4. Got: {}'.format(
+                    int(sync).to_bytes(SYNC_MARKER_SIZE, 'little')
+                )
+            )
+
+        entry = builder.append()
+        total_size = fill_entry(entry, ptr, pos, n_bytes, True)
+        if total_size < 0:
+            builder.n_entries -= 1
+            break
+
+        only_subobjects = entry.only_subobjects
+        content_start = pos + entry.header_size
+        content_end = pos + total_size
+        pos += total_size
+
+        if only_subobjects and max_depth != 0:
+            scan_subobjects(builder, ptr, content_start, content_end, 1, max_depth)
+
+    return builder.result(), pos
@@ -1,5 +1,6 @@
 import logging
-from collections import namedtuple
+from collections import namedtuple, deque
+from concurrent.futures import ThreadPoolExecutor
 
 from ..base import KNOWN_OBJECTS, EventIOFile, EventIOObject
 from ..exceptions import check_type
@@ -82,8 +83,24 @@ class IACTFile(EventIOFile):
     RunEnd
     '''
 
-    def __init__(self, path, zcat=True):
-        super().__init__(path, zcat=zcat)
+    def __init__(
+        self,
+        path,
+        zcat=True,
+        mmap=True,
+        seekable=False,
+        n_workers=1,
+        read_ahead=0,
+        instrumentation=False,
+    ):
+        super().__init__(
+            path, zcat=zcat, mmap=mmap, seekable=seekable, read_ahead=read_ahead,
+            instrumentation=instrumentation,
+        )
+
+        # with n_workers > 1, the photons of all telescopes are decoded
+        # in a thread pool and the next reuse is read ahead
+        self.n_workers = n_workers
 
         header_object = next(self)
         check_type(header_object, RunHeader)
@@ -118,9 +135,10 @@ class IACTFile(EventIOFile):
             self.n_telescopes,
         )
 
-    def __iter__(self):
+    def _iter_telescope_data(self):
         '''
-        Generator over the single array events
+        Walk through the events of the file, yielding a `ReuseInfo` tuple and
+        the `TelescopeData` object for each reuse of each shower
         '''
         self._next_header_pos = self._first_event_byte
         obj = next(self)
@@ -155,40 +173,24 @@ class IACTFile(EventIOFile):
             for reuse in range(n_reuses):
 
                 check_type(obj, TelescopeData)
-                telescope_data_obj = obj
-
-                photon_bunches = {}
-                emitter_bunches = {}
-                n_photons = {}
-                n_bunches = {}
-                for data in telescope_data_obj:
-                    if isinstance(data, Photons):
-                        photons, emitter = data.parse()
-                        photon_bunches[data.telescope] = photons
-                        emitter_bunches[data.telescope] = emitter
-                        n_photons[data.telescope] = data.n_photons
-                        n_bunches[data.telescope] = data.n_bunches
 
                 if len(array_offsets.dtype) == 3:
                     weight = array_offsets[reuse]['weight']
                 else:
                     weight = 1.0
 
-                yield Event(
+                info = ReuseInfo(
                     header=header,
-                    photon_bunches=photon_bunches,
                     time_offset=time_offset,
                     impact_x=-array_offsets[reuse]['x'],
                     impact_y=-array_offsets[reuse]['y'],
                     reuse_weight=weight,
                     event_number=header['event_number'],
                     reuse=reuse + 1,
-                    n_photons=n_photons,
-                    n_bunches=n_bunches,
                     longitudinal=longitudinal,
                     particles=particles,
-                    emitter=emitter_bunches,
                 )
+                yield info, obj
 
                 obj = next(self)
 
@@ -198,6 +200,111 @@ class IACTFile(EventIOFile):
 
         self.run_end = obj.parse()
 
+    def __iter__(self):
+        '''
+        Generator over the single array events
+        '''
+        if self.n_workers > 1:
+            yield from self._iter_parallel()
+            return
+
+        for info, telescope_data_obj in self._iter_telescope_data():
+            photons = [
+                (data, data.parse()) for data in telescope_data_obj
+                if isinstance(data, Photons)
+            ]
+            yield self._make_event(info, photons)
+
+    def _iter_parallel(self):
+        # the file is only read in this thread, the decoding of the
+        # bunches releases the gil and runs in the pool
+        with ThreadPoolExecutor(max_workers=self.n_workers) as executor:
+            pending = deque()
+            try:
+                for info, telescope_data_obj in self._iter_telescope_data():
+                    futures = [
+                        (data, executor.submit(data.decode, data.read_raw_bunches()))
+                        for data in telescope_data_obj
+                        if isinstance(data, Photons)
+                    ]
+                    pending.append((info, futures))
+
+                    # keep one reuse in flight while the current one is consumed
+                    if len(pending) > 1:
+                        yield self._finish(*pending.popleft())
+
+                while pending:
+                    yield self._finish(*pending.popleft())
+            finally:
+                for _, futures in pending:
+                    for _, future in futures:
+                        future.cancel()
+
+    def _finish(self, info, futures):
+        return self._make_event(
+            info, [(data, future.result()) for data, future in futures]
+        )
+
+    @staticmethod
+    def _make_event(info, photons):
+        '''Create the `Event` from the `ReuseInfo` and a list
+        of `Photons` objects with their parsed data'''
+        photon_bunches = {}
+        emitter_bunches = {}
+        n_photons = {}
+        n_bunches = {}
+        for data, (bunches, emitter) in photons:
+            photon_bunches[data.telescope] = bunches
+            emitter_bunches[data.telescope] = emitter
+            n_photons[data.telescope] = data.n_photons
+            n_bunches[data.telescope] = data.n_bunches
+
+        return Event(
+            header=info.header,
+            photon_bunches=photon_bunches,
+            time_offset=info.time_offset,
+            impact_x=info.impact_x,
+            impact_y=info.impact_y,
+            reuse_weight=info.reuse_weight,
+            event_number=info.event_number,
+            reuse=info.reuse,
+            n_photons=n_photons,
+            n_bunches=n_bunches,
+            longitudinal=info.longitudinal,
+            particles=info.particles,
+            emitter=emitter_bunches,
+        )
+
+    def iter_chunks(self, chunk_size=1000000, reuse_buffer=True):
+        '''
+        Generator over the photon bunches of all events in chunks
+        of at most `chunk_size` bunches, see `Photons.iter_chunks`.
+
+        Yields `PhotonChunk` tuples of the `ReuseInfo` of the event,
+        the telescope id and a structured array with the bunches.
+        With `reuse_buffer=True`, the bunch array is overwritten
+        when the next chunk is read.
+        '''
+        for info, telescope_data_obj in self._iter_telescope_data():
+            for data in telescope_data_obj:
+                if isinstance(data, Photons):
+                    chunks = data.iter_chunks(chunk_size, reuse_buffer=reuse_buffer)
+                    for bunches in chunks:
+                        yield PhotonChunk(info, data.telescope, bunches)
+
+
+ReuseInfo = namedtuple(
+    'ReuseInfo',
+    [
+        'header', 'time_offset', 'impact_x', 'impact_y',
+        'reuse_weight', 'event_number', 'reuse',
+        'longitudinal', 'particles',
+    ]
+)
+
+
+PhotonChunk = namedtuple('PhotonChunk', ['event', 'telescope_id', 'bunches'])
+
 
 EventTuple = namedtuple(
     'EventTuple',
@@ -16,6 +16,7 @@ from ..tools import (
 from ..base import EventIOObject
 from ..exceptions import WrongSize
 from ..version_handling import assert_version_in, assert_max_version
+from .parsing import decode_compact_bunches
 
 
 __all__ = [
@@ -159,6 +160,7 @@ class TelescopeData(EventIOObject):
     per simulated telescope
     '''
     eventio_type = 1204
+    __slots__ = ()
 
     def __str__(self):
         return '{}[{}](event_id={})'.format(
@@ -185,18 +187,49 @@ class Photons(EventIOObject):
     particle_dtype = np.dtype([(c, 'float32') for c in particle_columns])
     emitter_dtype = np.dtype([(c, 'float32') for c in emitter_columns])
 
+    # the bunch header (array, telescope, n_photons, n_bunches)
+    # is only read when one of its values is accessed
+    __slots__ = ('_bunch_header', )
+
     def __init__(self, header, filehandle):
         super().__init__(header, filehandle)
-        self.compact = bool(self.header.version // 1000 == 1)
-        self.array_id = self.header.id // 1000
-        self.telescope_id = self.header.id % 1000
+        self._bunch_header = None
+
+    @property
+    def compact(self):
+        return self.header.version // 1000 == 1
+
+    @property
+    def array_id(self):
+        return self.header.id // 1000
+
+    @property
+    def telescope_id(self):
+        return self.header.id % 1000
+
+    def read_bunch_header(self):
+        '''Read (array, telescope, n_photons, n_bunches) from the
+        beginning of the payload, only done once'''
+        if self._bunch_header is None:
+            self.seek(0)
+            self._bunch_header = read_from(self, 'hhfi')
+        return self._bunch_header
+
+    @property
+    def array(self):
+        return self.read_bunch_header()[0]
+
+    @property
+    def telescope(self):
+        return self.read_bunch_header()[1]
+
+    @property
+    def n_photons(self):
+        return self.read_bunch_header()[2]
 
-        (
-            self.array,
-            self.telescope,
-            self.n_photons,
-            self.n_bunches
-        ) = read_from(self, 'hhfi')
+    @property
+    def n_bunches(self):
+        return self.read_bunch_header()[3]
 
     def __str__(self):
         # IACTEXT writes particles at obslevel into photon bunch
@@ -227,7 +260,15 @@ class Photons(EventIOObject):
             wavelength:    wavelength in nm
             scattered: indicates if the photon was scattered in the atmosphere
         '''
-        data = self.parse_data()
+        return self.decode(self.read_raw_bunches())
+
+    def decode(self, raw):
+        '''Like `parse`, but decode `raw`, as returned by `read_raw_bunches`.
+
+        This does not access the file, so it can be used to decode the
+        bunches of several telescopes in parallel threads.
+        '''
+        data = self._decode_bunches(raw, self.n_bunches)
         # normal photon bunch
         if not (self.array_id == 999 and self.telescope_id == 999):
             emitter_mask = data['wavelength'] == np.float32(9999)
@@ -244,40 +285,70 @@ class Photons(EventIOObject):
         return data.view(self.particle_dtype)
 
     def parse_data(self):
-        if self.compact:
-            dtype = self.compact_dtype
-        else:
-            dtype = self.long_dtype
+        return self._decode_bunches(self.read_raw_bunches(), self.n_bunches)
 
-        if self.n_bunches == 0:
+    def read_raw_bunches(self):
+        '''Read the undecoded bunch data of this object'''
+        n_bunches = self.n_bunches
+        self.seek(12)
+        return self._read_raw(n_bunches)
+
+    def _read_raw(self, n_bunches):
+        dtype = self.compact_dtype if self.compact else self.long_dtype
+        data = self.view(n_bunches * dtype.itemsize)
+        if len(data) < n_bunches * dtype.itemsize:
+            raise EOFError('File seems to be truncated')
+        return data
+
+    def _decode_bunches(self, raw, n_bunches, out=None):
+        '''Decode `n_bunches` bunches from `raw`, converting compact bunches
+        into `out` if given'''
+        dtype = self.compact_dtype if self.compact else self.long_dtype
+        if n_bunches == 0:
             return np.array([], dtype=dtype)
 
-        self.seek(12)
-        bunches = np.frombuffer(
-            self.read(self.n_bunches * dtype.itemsize),
-            dtype=dtype,
-            count=self.n_bunches
+        bunches = np.frombuffer(raw, dtype=dtype, count=n_bunches)
+        if not self.compact:
+            return bunches
+
+        if out is None:
+            out = np.empty(n_bunches, dtype=self.long_dtype)
+        else:
+            out = out[:n_bunches]
+
+        decode_compact_bunches(
+            bunches.view(np.int16).reshape(n_bunches, len(self.columns)),
+            out.view(np.float32).reshape(n_bunches, len(self.columns)),
         )
+        return out
+
+    def iter_chunks(self, chunk_size=1000000, reuse_buffer=True):
+        '''
+        Iterate over the photon bunches in chunks of at most `chunk_size` bunches.
 
-        if self.compact:
-            bunches = bunches.astype(self.long_dtype)
-            bunches['x'] *= 0.1  # now in cm
-            bunches['y'] *= 0.1  # now in cm
+        Chunks are structured arrays with `long_dtype` like `parse_data`,
+        emitter information and particles are not separated.
+        This avoids having all bunches of huge showers in memory at once.
 
-            # if compact, cosines are scaled by a factor of 30000
-            bunches['cx'] /= 30000
-            bunches['cy'] /= 30000
-            # bernloehr clips in his implementation of the reader.
-            # we do so here as well. As cx and cy are cosines of angles,
-            # values with abs > 1 are not allowed.
-            bunches['cx'] = bunches['cx'].clip(min=-1., max=1.)
-            bunches['cy'] = bunches['cy'].clip(min=-1., max=1.)
+        If `reuse_buffer` is True, compact bunches are decoded into
+        the same array for each chunk, so the previous chunk is overwritten
+        when the next one is read. Copy chunks if you need to keep them.
+        '''
+        if chunk_size <= 0:
+            raise ValueError('chunk_size must be positive')
 
-            bunches['time'] *= 0.1  # in nanoseconds since first interaction.
-            bunches['zem'] = np.power(10., bunches['zem'] * 0.001)
-            bunches['photons'] *= 0.01
+        # the header has to be read before the bunches for non seekable files
+        self.read_bunch_header()
+        self.seek(12)
+        out = None
+        if self.compact and reuse_buffer:
+            out = np.empty(min(chunk_size, self.n_bunches), dtype=self.long_dtype)
 
-        return bunches
+        remaining = self.n_bunches
+        while remaining > 0:
+            n_bunches = min(chunk_size, remaining)
+            yield self._decode_bunches(self._read_raw(n_bunches), n_bunches, out=out)
+            remaining -= n_bunches
 
 
 class CameraLayout(EventIOObject):
@@ -290,35 +361,40 @@ class TriggerTime(EventIOObject):
 
 class PhotoElectrons(EventIOObject):
     eventio_type = 1208
-    from ..var_int import parse_1208
+    __slots__ = ()
+    from ..var_int import parse_1208, parse_photoelectrons, parse_photoelectrons_merged
 
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
-        self.array_id = header.id // 1000
-        self.telescope_id = header.id % 1000
+    @property
+    def array_id(self):
+        return self.header.id // 1000
+
+    @property
+    def telescope_id(self):
+        return self.header.id % 1000
 
     def parse(self):
         assert_version_in(self, [1, 2, 3])
         self.seek(0)
+        return PhotoElectrons.parse_photoelectrons(self.view(), self.header.version)
 
-        pe = {}
-        pe['n_pe'] = read_int(self)
-        pe['n_pixels'] = read_int(self)
-        if self.header.version > 1:
-            flags = read_short(self)
-        else:
-            flags = 0
-
-        pe['non_empty'] = read_int(self)
+    @staticmethod
+    def parse_merged(photo_electrons):
+        '''Parse several `PhotoElectrons` objects, e.g. of all telescopes
+        of one `TelescopeData` block, into shared flat arrays,
+        see `eventio.var_int.parse_photoelectrons_merged`.
 
-        data = self.read()
-
-        pe.update(PhotoElectrons.parse_1208(
-            data, pe['n_pixels'], pe['non_empty'],
-            self.header.version, flags, pe['n_pe']
-        ))
-
-        return pe
+        `photo_electrons` can be a generator, the payload of each
+        object is read when it is yielded.
+        '''
+        payloads = []
+        versions = []
+        for o in photo_electrons:
+            assert_version_in(o, [1, 2, 3])
+            o.seek(0)
+            payloads.append(o.view())
+            versions.append(o.header.version)
+
+        return PhotoElectrons.parse_photoelectrons_merged(payloads, versions)
 
     def __str__(self):
         return super().__str__() + '(array_id={}, telescope_id={})'.format(
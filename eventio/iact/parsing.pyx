@@ -0,0 +1,63 @@
+# cython: language_level=3
+import cython
+from libc.stdint cimport int16_t, uint64_t
+from libc.math cimport powf
+import numpy as np
+cimport numpy as np
+
+np.import_array()
+
+
+cdef enum:
+    N_COLUMNS = 8
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cpdef decode_compact_bunches(const int16_t[:, ::1] compact, float[:, ::1] output):
+    '''Convert compact photon bunches to the long format in a single pass.
+
+    Parameters
+    ----------
+    compact: np.ndarray[int16]
+        array of shape (n_bunches, 8), the raw compact bunches
+    output: np.ndarray[float32]
+        array of shape (n_bunches, 8), the decoded bunches are written here.
+
+    Columns are x, y, cx, cy, time, zem, photons and wavelength.
+    The scaling is the same as in Bernlöhr's reader, including clipping
+    the direction cosines to [-1, 1].
+    '''
+    cdef uint64_t n_bunches = compact.shape[0]
+    cdef uint64_t i
+    cdef float cx, cy
+    # float32 constants, so the results are the same as the
+    # float32 numpy operations used before
+    cdef float tenth = 0.1, hundredth = 0.01, thousandth = 0.001
+    cdef float cosine_scale = 30000, ten = 10
+
+    if compact.shape[1] != N_COLUMNS or output.shape[1] != N_COLUMNS:
+        raise ValueError('Photon bunches need to have {} columns'.format(N_COLUMNS))
+
+    if output.shape[0] < n_bunches:
+        raise ValueError('Output has space for {} bunches, need {}'.format(
+            output.shape[0], n_bunches
+        ))
+
+    with nogil:
+        for i in range(n_bunches):
+            output[i, 0] = compact[i, 0] * tenth  # now in cm
+            output[i, 1] = compact[i, 1] * tenth  # now in cm
+
+            # cosines are scaled by a factor of 30000
+            cx = compact[i, 2] / cosine_scale
+            cy = compact[i, 3] / cosine_scale
+            output[i, 2] = min(max(cx, -1), 1)
+            output[i, 3] = min(max(cy, -1), 1)
+
+            output[i, 4] = compact[i, 4] * tenth  # in nanoseconds since first interaction.
+            output[i, 5] = powf(ten, compact[i, 5] * thousandth)
+            output[i, 6] = compact[i, 6] * hundredth
+            output[i, 7] = compact[i, 7]
+
+    return output
@@ -0,0 +1,178 @@
+'''
+Persistent index of the objects in an eventio file.
+
+The index is built from a scan of the object headers
+(see `EventIOFile.scan_objects`) and can be stored next to the file,
+as `<file>.eventio-idx`, to be reused by later runs.
+'''
+import os
+import logging
+
+import numpy as np
+
+from .header import OBJECT_INDEX_DTYPE
+from .sources import as_source, file_stat, is_remote, open_binary
+
+log = logging.getLogger(__name__)
+
+
+class EventIOIndex:
+    '''
+    Byte offsets of the objects in an eventio file.
+
+    Attributes
+    ----------
+    objects: np.ndarray[OBJECT_INDEX_DTYPE]
+        The scanned objects, see `eventio.header.scan_objects`
+    end: int
+        Position after the last complete toplevel object
+    max_depth: int
+        Nesting level up to which subobjects were scanned
+    file_size: int
+        size of the indexed file, used to detect stale indices
+    file_mtime_ns: int
+        modification time of the indexed file, used to detect stale indices,
+        -1 if unknown (e.g. for some remote files)
+    '''
+    format_version = 1
+    suffix = '.eventio-idx'
+
+    def __init__(self, objects, end, max_depth, file_size, file_mtime_ns):
+        self.objects = objects
+        self.end = end
+        self.max_depth = max_depth
+        self.file_size = file_size
+        self.file_mtime_ns = file_mtime_ns
+
+    @classmethod
+    def build(cls, path, max_depth=1, payloads=None):
+        '''Scan the file at `path`, for `payloads` see `eventio.base.scan_stream`'''
+        from .base import EventIOFile
+
+        file_size, file_mtime_ns = file_stat(path)
+        with EventIOFile(path) as f:
+            objects, end = f.scan_objects(max_depth=max_depth, payloads=payloads)
+
+        return cls(
+            objects,
+            end=end,
+            max_depth=max_depth,
+            file_size=file_size,
+            file_mtime_ns=file_mtime_ns if file_mtime_ns is not None else -1,
+        )
+
+    @classmethod
+    def index_path(cls, path):
+        '''Location of the index of `path`, a `ByteSource` for remote files'''
+        if is_remote(path):
+            return as_source(path).with_suffix(cls.suffix)
+        return str(path) + cls.suffix
+
+    @classmethod
+    def load(cls, index_path):
+        with open_binary(index_path) as f, np.load(f, allow_pickle=False) as data:
+            format_version = int(data['format_version'])
+            if format_version != cls.format_version:
+                raise ValueError(
+                    'Unsupported index format version {} in {}'.format(
+                        format_version, index_path
+                    )
+                )
+
+            return cls(
+                objects=data['objects'],
+                end=int(data['end']),
+                max_depth=int(data['max_depth']),
+                file_size=int(data['file_size']),
+                file_mtime_ns=int(data['file_mtime_ns']),
+            )
+
+    def save(self, index_path):
+        # write to a temporary file first, so concurrent readers
+        # never see an incomplete index
+        tmp_path = '{}.{}.tmp'.format(index_path, os.getpid())
+        try:
+            with open(tmp_path, 'wb') as f:
+                np.savez(
+                    f,
+                    format_version=self.format_version,
+                    objects=self.objects,
+                    end=self.end,
+                    max_depth=self.max_depth,
+                    file_size=self.file_size,
+                    file_mtime_ns=self.file_mtime_ns,
+                )
+            os.replace(tmp_path, index_path)
+        except BaseException:
+            if os.path.exists(tmp_path):
+                os.remove(tmp_path)
+            raise
+
+    def is_valid_for(self, path, max_depth=0):
+        '''Check if this index describes the current state of the file at `path`'''
+        file_size, file_mtime_ns = file_stat(path)
+        if file_mtime_ns is None or self.file_mtime_ns < 0:
+            file_mtime_ns = self.file_mtime_ns
+        return (
+            file_size == self.file_size
+            and file_mtime_ns == self.file_mtime_ns
+            and (self.max_depth < 0 or (0 <= max_depth <= self.max_depth))
+        )
+
+    @classmethod
+    def for_file(cls, path, max_depth=1, cache=True, index_path=None, payloads=None):
+        '''Get the index for the file at `path`.
+
+        If `cache` is True, a valid index stored next to the file
+        (or at `index_path`, if given) is reused,
+        and a newly built index is stored for later use.
+        Indices of remote files are only read, not stored, unless
+        `index_path` is a local path.
+
+        `payloads` is passed to `build`. It is only filled if the index
+        had to be built by scanning a compressed or remote file.
+        '''
+        if index_path is None:
+            index_path = cls.index_path(path)
+
+        if is_remote(index_path):
+            exists = as_source(index_path).exists()
+        else:
+            exists = os.path.isfile(index_path)
+
+        if cache and exists:
+            try:
+                index = cls.load(index_path)
+                if index.is_valid_for(path, max_depth=max_depth):
+                    log.info('Using index file {}'.format(index_path))
+                    return index
+                log.info('Index file {} is outdated'.format(index_path))
+            except Exception as e:
+                log.warning('Could not read index file {}: {}'.format(index_path, e))
+
+        index = cls.build(path, max_depth=max_depth, payloads=payloads)
+
+        if cache and not is_remote(index_path):
+            try:
+                index.save(index_path)
+                log.info('Stored index file {}'.format(index_path))
+            except OSError as e:
+                log.warning('Could not store index file {}: {}'.format(index_path, e))
+
+        return index
+
+    @property
+    def toplevel(self):
+        return self.objects[self.objects['depth'] == 0]
+
+    def subobjects(self, offset):
+        '''The direct subobjects of the toplevel object starting at `offset`'''
+        objects = self.objects
+        start = np.searchsorted(objects['offset'], offset, side='right')
+        toplevel_after = np.nonzero(objects['depth'][start:] == 0)[0]
+        stop = start + toplevel_after[0] if len(toplevel_after) else len(objects)
+        rows = objects[start:stop]
+        return rows[rows['depth'] == 1]
+
+    def __len__(self):
+        return len(self.objects)
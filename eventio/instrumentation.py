@@ -0,0 +1,130 @@
+'''
+Optional instrumentation of reading eventio files.
+
+If an `EventIOFile` is opened with ``instrumentation=True``
+(or an existing `Instrumentation` to accumulate over several files),
+the number of objects, their payload size, the time spent
+in their ``parse`` method and the time spent reading their data from the
+file are collected per object type, version and variant
+(e.g. the zero suppression mode of ADC data).
+
+The time spent reading data includes the decompression of compressed files.
+The parse time includes the time spent reading the object's payload and,
+for objects that parse their subobjects, the time spent parsing
+those, so times of nested objects are not additive.
+
+Only objects created while iterating over the file are instrumented,
+e.g. array events parsed in worker processes
+with ``SimTelFile(n_workers > 1)`` are not included.
+'''
+from functools import wraps
+from time import perf_counter
+
+
+__all__ = ['Instrumentation', 'ObjectStatistics']
+
+
+class ObjectStatistics:
+    '''Accumulated statistics of one kind of eventio objects'''
+    __slots__ = ('name', 'n_objects', 'n_bytes', 'n_parsed', 'parse_seconds', 'io_seconds')
+
+    def __init__(self, name):
+        self.name = name
+        self.n_objects = 0
+        self.n_bytes = 0
+        self.n_parsed = 0
+        self.parse_seconds = 0.0
+        self.io_seconds = 0.0
+
+    def as_dict(self):
+        return {k: getattr(self, k) for k in self.__slots__}
+
+
+class Instrumentation:
+    '''
+    Collects statistics about the objects read from eventio files.
+
+    Statistics are stored by (type, version, variant), where variant
+    is the ``instrumentation_variant`` of the object, None for most objects.
+    Not thread safe, objects of one `Instrumentation` should
+    only be read and parsed in one thread.
+    '''
+    # prometheus metric name, statistic and help text
+    metrics = (
+        ('objects_total', 'n_objects', 'Number of eventio objects read'),
+        ('bytes_total', 'n_bytes', 'Payload bytes of the eventio objects read'),
+        ('parsed_total', 'n_parsed', 'Number of eventio objects parsed'),
+        ('parse_seconds_total', 'parse_seconds', 'Time spent parsing eventio objects'),
+        ('io_seconds_total', 'io_seconds', 'Time spent reading and decompressing eventio objects'),
+    )
+
+    def __init__(self):
+        self._stats = {}
+
+    def _get(self, obj):
+        header = obj.header
+        key = (header.type, header.version, obj.instrumentation_variant)
+        stats = self._stats.get(key)
+        if stats is None:
+            stats = self._stats[key] = ObjectStatistics(obj.__class__.__name__)
+        return stats
+
+    def record_object(self, obj, io_seconds=0.0):
+        '''Register a newly created object of an instrumented file'''
+        obj._instrumentation = self
+        stats = self._get(obj)
+        stats.n_objects += 1
+        stats.n_bytes += obj.header.content_size
+        stats.io_seconds += io_seconds
+
+    def record_io(self, obj, seconds):
+        self._get(obj).io_seconds += seconds
+
+    def record_parse(self, obj, seconds):
+        stats = self._get(obj)
+        stats.n_parsed += 1
+        stats.parse_seconds += seconds
+
+    def reset(self):
+        self._stats.clear()
+
+    def as_dict(self):
+        '''The collected statistics as a dict mapping
+        (type, version, variant) to a dict of the statistics'''
+        return {key: stats.as_dict() for key, stats in self._stats.items()}
+
+    def to_prometheus(self, prefix='eventio'):
+        '''The collected statistics in the prometheus text exposition format'''
+        lines = []
+        for metric, attribute, description in self.metrics:
+            name = '{}_{}'.format(prefix, metric)
+            lines.append('# HELP {} {}'.format(name, description))
+            lines.append('# TYPE {} counter'.format(name))
+
+            for (type_, version, variant), stats in sorted(
+                self._stats.items(), key=lambda item: (item[0][0], item[0][1], str(item[0][2]))
+            ):
+                labels = 'type="{}",version="{}",name="{}"'.format(type_, version, stats.name)
+                if variant is not None:
+                    labels += ',variant="{}"'.format(variant)
+                lines.append('{}{{{}}} {}'.format(name, labels, getattr(stats, attribute)))
+
+        return '\n'.join(lines) + '\n'
+
+
+def timed_parse(parse):
+    '''Decorator for the `parse` methods of `EventIOObject` subclasses,
+    recording the parse time if the object is instrumented'''
+    @wraps(parse)
+    def wrapper(self, *args, **kwargs):
+        instrumentation = self._instrumentation
+        if instrumentation is None:
+            return parse(self, *args, **kwargs)
+
+        start = perf_counter()
+        try:
+            return parse(self, *args, **kwargs)
+        finally:
+            instrumentation.record_parse(self, perf_counter() - start)
+
+    return wrapper
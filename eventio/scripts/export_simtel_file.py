@@ -0,0 +1,47 @@
+'''
+Export the events of a simtel file into columnar
+parquet, arrow or hdf5 files.
+'''
+from argparse import ArgumentParser
+from ..simtel.export import export_simtel, DEFAULT_BATCH_SIZE
+
+
+parser = ArgumentParser(description=__doc__)
+parser.add_argument('inputfile', help='Input simtel file')
+parser.add_argument(
+    'output',
+    help='Output directory for parquet and arrow, output file for hdf5',
+)
+parser.add_argument(
+    '--format', choices=['parquet', 'arrow', 'hdf5'],
+    help='Output format, default is hdf5 for outputs ending with .h5 or .hdf5, else parquet',
+)
+parser.add_argument(
+    '--waveforms', action='store_true', help='Also export the adc samples',
+)
+parser.add_argument(
+    '--batch-size', type=int, default=DEFAULT_BATCH_SIZE,
+    help='Number of rows written at once',
+)
+parser.add_argument(
+    '--telescopes', type=int, nargs='+',
+    help='Only export the data of these telescopes',
+)
+
+
+def main():
+    args = parser.parse_args()
+
+    n_events = export_simtel(
+        args.inputfile,
+        args.output,
+        format=args.format,
+        waveforms=args.waveforms,
+        batch_size=args.batch_size,
+        allowed_telescopes=args.telescopes,
+    )
+    print('Exported {} events'.format(n_events))
+
+
+if __name__ == '__main__':
+    main()
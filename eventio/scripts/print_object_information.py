@@ -1,7 +1,10 @@
 from eventio import EventIOFile
+from eventio.base import KNOWN_OBJECTS, EventIOObject
+from eventio.file_types import is_gzip, is_zstd
 from argparse import ArgumentParser
 from collections import Counter, namedtuple
 import json
+import os
 import warnings
 from eventio.simtel import TrackingPosition, TelescopeEvent
 
@@ -34,6 +37,26 @@ def count_versions(f, level=0):
     return c
 
 
+def count_versions_from_index(index):
+    '''Same as `count_versions` but using the result of `EventIOFile.scan_objects`'''
+    c = Counter()
+    rows = zip(index['type'], index['version'], index['depth'])
+    for (eventio_type, version, level), n in Counter(rows).items():
+        cls = KNOWN_OBJECTS.get(int(eventio_type), EventIOObject)
+        if issubclass(cls, TrackingPosition):
+            eventio_type = 2100
+        elif issubclass(cls, TelescopeEvent):
+            eventio_type = 2200
+
+        c[ObjectInfo(
+            type=int(eventio_type),
+            level=int(level),
+            version=int(version),
+            name=(cls.__module__ + '.' + cls.__qualname__)[8:],
+        )] += n
+    return c
+
+
 parser = ArgumentParser()
 parser.add_argument('inputfile')
 parser.add_argument('--json', help='print json', action='store_true')
@@ -43,7 +66,12 @@ def main():
     args = parser.parse_args()
 
     with EventIOFile(args.inputfile) as f:
-        counter = count_versions(f)
+        index, end = f.scan_objects(max_depth=-1)
+    counter = count_versions_from_index(index)
+
+    compressed = is_gzip(args.inputfile) or is_zstd(args.inputfile)
+    if not compressed and end < os.path.getsize(args.inputfile):
+        warnings.warn("File seems to be truncated")
 
     if args.json:
         object_info = [
@@ -0,0 +1,52 @@
+'''
+Rewrite an eventio file into a zstd file with frames aligned to
+toplevel objects and a seek table, optionally keeping only
+some object types or telescopes.
+'''
+from argparse import ArgumentParser
+from ..writer import repack, DEFAULT_FRAME_SIZE
+from .cut_eventio_file import parse_size
+
+
+parser = ArgumentParser(description=__doc__)
+parser.add_argument('inputfile', help='Input eventio file')
+parser.add_argument(
+    'outputfile',
+    help='Output file, if ending with .zst, it is written zstd compressed'
+)
+parser.add_argument(
+    '--frame-size',
+    default=str(DEFAULT_FRAME_SIZE),
+    help='Minimum uncompressed size of a zstd frame. You can use k, M, G suffixes.',
+)
+parser.add_argument('--level', type=int, default=3, help='zstd compression level')
+parser.add_argument(
+    '--threads', type=int, default=1, help='Number of compression threads'
+)
+parser.add_argument(
+    '--types', type=int, nargs='+',
+    help='Only write toplevel objects of these types',
+)
+parser.add_argument(
+    '--telescopes', type=int, nargs='+',
+    help='Remove the event data of all other telescopes',
+)
+
+
+def main():
+    args = parser.parse_args()
+
+    n_objects = repack(
+        args.inputfile,
+        args.outputfile,
+        types=args.types,
+        telescopes=args.telescopes,
+        frame_size=parse_size(args.frame_size),
+        level=args.level,
+        n_threads=args.threads,
+    )
+    print('Wrote {} toplevel objects'.format(n_objects))
+
+
+if __name__ == '__main__':
+    main()
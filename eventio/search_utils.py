@@ -1,4 +1,7 @@
 from eventio import EventIOFile
+from eventio.base import KNOWN_OBJECTS, EventIOObject, MemoryMappedFile
+from eventio.header import scan_objects
+import numpy as np
 import warnings
 
 
@@ -17,7 +20,46 @@ def collect_toplevel_of_type(f, eventio_type):
     return list(yield_toplevel_of_type(f, eventio_type))
 
 
+def _known_types(eventio_type):
+    '''All eventio type ids of KNOWN_OBJECTS that are instances of eventio_type.
+
+    Returns None if also unknown objects would match.
+    '''
+    if issubclass(EventIOObject, eventio_type):
+        return None
+
+    return np.array([
+        t for t, cls in KNOWN_OBJECTS.items()
+        if t is not None and issubclass(cls, eventio_type)
+    ], dtype=np.uint32)
+
+
+def _yield_toplevel_of_type_indexed(f, types):
+    filehandle = f._filehandle
+    index, end = scan_objects(filehandle.buffer, offset=f._next_header_pos)
+
+    for offset in index['offset'][np.isin(index['type'], types)]:
+        f._next_header_pos = int(offset)
+        yield next(f)
+
+    f._next_header_pos = end
+    if end < filehandle.size:
+        warnings.warn("File seems to be truncated")
+
+
 def yield_toplevel_of_type(f, eventio_type):
+    # for memory mapped files, only the headers of matching objects
+    # have to be parsed in python
+    if (
+        isinstance(f, EventIOFile)
+        and f.next is None
+        and isinstance(f._filehandle, MemoryMappedFile)
+    ):
+        types = _known_types(eventio_type)
+        if types is not None:
+            yield from _yield_toplevel_of_type_indexed(f, types)
+            return
+
     try:
         for o in f:
             if isinstance(o, eventio_type):
@@ -0,0 +1,161 @@
+'''
+Iterate the events of a simtel file from asyncio code.
+'''
+import asyncio
+from concurrent.futures import ThreadPoolExecutor
+import logging
+
+from ..base import MemoryMappedFile, OffsetBytesIO
+from .simtelfile import SimTelFile
+
+
+__all__ = ['AsyncSimTelFile']
+
+log = logging.getLogger(__name__)
+
+
+def _fetch_object(f):
+    '''Read the next toplevel object of `f` including its payload,
+    so it can be parsed independently of the file. None at the end of the file.'''
+    try:
+        o = next(f)
+    except StopIteration:
+        return None
+
+    if isinstance(o._filehandle, OffsetBytesIO):
+        return o
+
+    header = o.header
+    o.seek(0)
+    if isinstance(o._filehandle, MemoryMappedFile):
+        # a view of the memory map would only be paged in when decoding,
+        # copy the payload so the data is really read on this thread
+        payload = o.read()
+    else:
+        payload = o.view()
+    return o.__class__(header, OffsetBytesIO(payload, header.content_address))
+
+
+class AsyncSimTelFile:
+    '''
+    Asynchronous iteration over the array events of a simtel file,
+    yielding the same events as iterating a `SimTelFile`:
+
+    .. code:: python
+
+        async with AsyncSimTelFile(path) as f:
+            async for event in f:
+                ...
+
+    Opening the file, reading and decompressing run on one background
+    thread, decoding the objects on another one, so the event loop is never
+    blocked. While an object is decoded, the next toplevel object is
+    already read.
+
+    Parameters
+    ----------
+    path: str
+        Path or url of the simtel file
+    **kwargs:
+        Further arguments for `SimTelFile`, n_workers > 1 and
+        instrumentation are not supported
+
+    Attributes
+    ----------
+    simtel_file: SimTelFile or None
+        The underlying file, available after opening it.
+        It should not be used while iterating.
+    '''
+    def __init__(self, path, **kwargs):
+        if kwargs.get('n_workers', 1) > 1:
+            raise ValueError('AsyncSimTelFile does not support n_workers > 1')
+        # objects are read and parsed on different threads,
+        # `Instrumentation` is not thread safe
+        if kwargs.get('instrumentation'):
+            raise ValueError('AsyncSimTelFile does not support instrumentation')
+
+        self.path = path
+        self.kwargs = kwargs
+        self.simtel_file = None
+
+        self._io_executor = ThreadPoolExecutor(max_workers=1)
+        self._decode_executor = ThreadPoolExecutor(max_workers=1)
+        self._fetch = None
+        self._started = False
+        self._closed = False
+
+    async def _run(self, executor, func, *args):
+        return await asyncio.get_running_loop().run_in_executor(executor, func, *args)
+
+    async def open(self):
+        '''Open the file and read its header, called automatically on first use'''
+        if self._closed:
+            raise ValueError('I/O operation on closed file')
+        if self.simtel_file is None:
+            self.simtel_file = await self._run(
+                self._io_executor, lambda: SimTelFile(self.path, **self.kwargs)
+            )
+        return self
+
+    def _start_fetch(self):
+        self._fetch = asyncio.ensure_future(
+            self._run(self._io_executor, _fetch_object, self.simtel_file)
+        )
+
+    def _decode(self, o):
+        self.simtel_file.next_low_level(o)
+        return self.simtel_file.try_build_event()
+
+    def __aiter__(self):
+        return self
+
+    async def __anext__(self):
+        await self.open()
+        f = self.simtel_file
+
+        if not self._started:
+            self._started = True
+            self._start_fetch()
+            # reading the header might already have completed an event
+            event = await self._run(self._decode_executor, f.try_build_event)
+            if event is not None:
+                return event
+
+        while self._fetch is not None:
+            o = await self._fetch
+            if o is None:
+                self._fetch = None
+                break
+
+            # read the next object while this one is decoded
+            self._start_fetch()
+            event = await self._run(self._decode_executor, self._decode, o)
+            if event is not None:
+                return event
+
+        raise StopAsyncIteration
+
+    async def close(self):
+        '''Close the file, waiting for reads that are still running'''
+        if self._closed:
+            return
+        self._closed = True
+
+        if self._fetch is not None:
+            try:
+                await self._fetch
+            except Exception as e:
+                log.debug('Ignoring error of pending read: {}'.format(e))
+            self._fetch = None
+
+        if self.simtel_file is not None:
+            await self._run(self._io_executor, self.simtel_file.close)
+
+        self._io_executor.shutdown(wait=False)
+        self._decode_executor.shutdown(wait=False)
+
+    async def __aenter__(self):
+        return await self.open()
+
+    async def __aexit__(self, exc_type, exc_value, traceback):
+        await self.close()
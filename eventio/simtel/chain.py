@@ -0,0 +1,142 @@
+'''
+Iterate the events of many simtel files, e.g. all runs of a production,
+as one event stream.
+'''
+from collections import deque
+from concurrent.futures import ThreadPoolExecutor
+import logging
+
+from .simtelfile import SimTelFile
+
+
+__all__ = ['SimTelFileChain']
+
+log = logging.getLogger(__name__)
+
+
+class SimTelFileChain:
+    '''
+    Read the array events of several simtel files one after another.
+
+    While the events of one file are consumed, the next `prefetch` files
+    are opened on a background thread: their run headers and telescope
+    descriptions are parsed and, for compressed files, the read-ahead
+    buffer (see `read_ahead`) starts to fill.
+
+    Telescope descriptions that are identical in all files
+    (`eventio.simtel.simtelfile.cached_description_types`) are only parsed
+    once, the files share the same dicts for them, which must
+    therefore not be modified.
+
+    Parameters
+    ----------
+    paths: iterable of str
+        The simtel files, read in this order
+    prefetch: int
+        Number of files opened in advance, 0 to open each file
+        only when the previous one is done
+    read_ahead: int
+        Passed to `SimTelFile`, number of blocks decompressed in advance
+    **kwargs:
+        Further arguments for `SimTelFile`
+
+    Attributes
+    ----------
+    current_file: SimTelFile or None
+        The file the last event was read from
+    current_path: str or None
+        Its path
+    description_cache: dict
+        The cache of parsed telescope descriptions shared by all files
+    '''
+    def __init__(self, paths, prefetch=1, read_ahead=4, **kwargs):
+        if prefetch < 0:
+            raise ValueError('prefetch must not be negative')
+
+        self.paths = list(paths)
+        self.prefetch = prefetch
+        self.description_cache = kwargs.pop('description_cache', None)
+        if self.description_cache is None:
+            self.description_cache = {}
+
+        self.kwargs = kwargs
+        self.kwargs['read_ahead'] = read_ahead
+        self.kwargs['description_cache'] = self.description_cache
+
+        self.current_file = None
+        self.current_path = None
+
+        self._next_path = 0
+        self._pending = deque()
+        self._executor = None
+        if prefetch > 0:
+            self._executor = ThreadPoolExecutor(max_workers=1)
+
+    def __len__(self):
+        return len(self.paths)
+
+    def _open(self, path):
+        log.info('Opening {}'.format(path))
+        return SimTelFile(path, **self.kwargs)
+
+    def _fill_pending(self):
+        while len(self._pending) < self.prefetch and self._next_path < len(self.paths):
+            path = self.paths[self._next_path]
+            self._next_path += 1
+            self._pending.append((path, self._executor.submit(self._open, path)))
+
+    def iter_files(self):
+        '''Yield the opened `SimTelFile` of each path, the previous file
+        is closed when the next one is requested'''
+        while True:
+            self._close_current()
+
+            if self._executor is not None:
+                self._fill_pending()
+                if not self._pending:
+                    return
+                path, future = self._pending.popleft()
+                # open the next ones while this one is read
+                self._fill_pending()
+                f = future.result()
+            else:
+                if self._next_path >= len(self.paths):
+                    return
+                path = self.paths[self._next_path]
+                self._next_path += 1
+                f = self._open(path)
+
+            self.current_path = path
+            self.current_file = f
+            yield f
+
+    def __iter__(self):
+        for f in self.iter_files():
+            yield from f
+
+    def _close_current(self):
+        if self.current_file is not None:
+            self.current_file.close()
+        self.current_file = None
+        self.current_path = None
+
+    def close(self):
+        self._close_current()
+
+        while self._pending:
+            _, future = self._pending.popleft()
+            if not future.cancel():
+                try:
+                    future.result().close()
+                except Exception as e:
+                    log.warning('Could not open prefetched file: {}'.format(e))
+
+        if self._executor is not None:
+            self._executor.shutdown(wait=True)
+            self._executor = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
@@ -0,0 +1,35 @@
+'''
+Selection of the decoders used for the adc data of telescope events.
+
+``'cython'``
+    The default decoders of `eventio.simtel.parsing`
+``'hessio'``
+    The optional `eventio.simtel.hessio` extension, using the routines
+    of the hessioxxx library. Only available if pyeventio was built with
+    the environment variable ``EVENTIO_BUILD_HESSIO=1``.
+'''
+
+__all__ = ['ENGINES', 'load_engine']
+
+ENGINES = ('cython', 'hessio')
+
+
+def load_engine(engine):
+    '''
+    Returns the module implementing `engine`, None for the default decoders.
+    Raises an IOError if the extension for `engine` is not available.
+    '''
+    if engine not in ENGINES:
+        raise ValueError('Unknown engine {!r}, supported are {}'.format(engine, ENGINES))
+
+    if engine == 'cython':
+        return None
+
+    try:
+        from . import hessio
+    except ImportError:
+        raise IOError(
+            'The hessio engine is not available,'
+            ' rebuild pyeventio with EVENTIO_BUILD_HESSIO=1'
+        )
+    return hessio
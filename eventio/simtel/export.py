@@ -0,0 +1,444 @@
+'''
+Columnar export of simtel files.
+
+`export_simtel` reads a simtel file once and writes the
+event level monte carlo and trigger information, the per telescope
+image parameters and optionally the adc samples as tables.
+Values are copied directly into preallocated numpy column buffers,
+which are written in batches of `batch_size` rows as Arrow record batches
+(parquet or arrow ipc files) or appended to chunked HDF5 datasets.
+
+Tables:
+
+``events``
+    One row per array event with the `MCShower`, `MCEvent`
+    and `TriggerInformation` scalars
+``telescope_events``
+    One row per telescope event with the `ImageParameters` scalars
+``waveforms/tel_<telescope_id>``
+    Only with ``waveforms=True``, one table per telescope with
+    the event id and the adc samples of shape (n_gains, n_pixels, n_samples)
+
+Values missing in an event, e.g. image parameters not written for
+a telescope, are filled with NaN for floats and -1 for integers.
+Calibration events are not exported.
+'''
+import os
+import numpy as np
+
+from .simtelfile import SimTelFile
+
+
+__all__ = [
+    'export_simtel',
+    'ColumnBuffer',
+    'ArrowWriter',
+    'HDF5Writer',
+    'EVENT_COLUMNS',
+    'TELESCOPE_EVENT_COLUMNS',
+]
+
+
+DEFAULT_BATCH_SIZE = 10000
+DEFAULT_WAVEFORM_BATCH_SIZE = 100
+
+
+EVENT_COLUMNS = (
+    ('event_id', np.int64),
+    # MCShower
+    ('shower', np.int32),
+    ('primary_id', np.int32),
+    ('energy', np.float32),
+    ('azimuth', np.float32),
+    ('altitude', np.float32),
+    ('depth_start', np.float32),
+    ('h_first_int', np.float32),
+    ('xmax', np.float32),
+    ('hmax', np.float32),
+    ('emax', np.float32),
+    ('cmax', np.float32),
+    # MCEvent
+    ('shower_num', np.int32),
+    ('xcore', np.float32),
+    ('ycore', np.float32),
+    ('aweight', np.float32),
+    # TriggerInformation
+    ('cpu_time_s', np.int32),
+    ('cpu_time_ns', np.int32),
+    ('gps_time_s', np.int32),
+    ('gps_time_ns', np.int32),
+    ('trigger_pattern', np.int32),
+    ('data_pattern', np.int32),
+    ('n_triggered_telescopes', np.int16),
+    ('n_telescopes_with_data', np.int16),
+)
+
+TELESCOPE_EVENT_COLUMNS = (
+    ('event_id', np.int64),
+    ('telescope_id', np.int16),
+    # ImageParameters
+    ('flags', np.int64),
+    ('cut_id', np.int16),
+    ('pixels', np.int16),
+    ('n_sat', np.int16),
+    ('clip_amp', np.float32),
+    ('amplitude', np.float32),
+    ('x', np.float32),
+    ('y', np.float32),
+    ('phi', np.float32),
+    ('l', np.float32),
+    ('w', np.float32),
+    ('n_conc', np.int16),
+    ('concentration', np.float32),
+    ('x_err', np.float32),
+    ('y_err', np.float32),
+    ('phi_err', np.float32),
+    ('l_err', np.float32),
+    ('w_err', np.float32),
+    ('skewness', np.float32),
+    ('skewness_err', np.float32),
+    ('kurtosis', np.float32),
+    ('kurtosis_err', np.float32),
+    ('n_hot', np.int16),
+    ('tm_slope', np.float32),
+    ('tm_residual', np.float32),
+    ('tm_width1', np.float32),
+    ('tm_width2', np.float32),
+    ('tm_rise', np.float32),
+)
+
+
+def fill_value(dtype):
+    dtype = np.dtype(dtype)
+    if dtype.kind == 'f':
+        return np.nan
+    if dtype.kind == 'b':
+        return False
+    return -1
+
+
+class ColumnBuffer:
+    '''
+    Preallocated columns of one table, written to `writer`
+    every `batch_size` rows.
+
+    Parameters
+    ----------
+    writer: ArrowWriter or HDF5Writer
+        Receives the full batches
+    table: str
+        Name of the table
+    columns: sequence of tuples
+        (name, dtype) or (name, dtype, shape) for each column,
+        where shape is the shape of a single value
+    batch_size: int
+        Number of rows per batch
+    '''
+    def __init__(self, writer, table, columns, batch_size=DEFAULT_BATCH_SIZE):
+        self.writer = writer
+        self.table = table
+        self.batch_size = batch_size
+        self.columns = {}
+        self.fill_values = {}
+        for name, dtype, *shape in columns:
+            shape = tuple(shape[0]) if shape else ()
+            self.columns[name] = np.empty((batch_size, ) + shape, dtype=dtype)
+            self.fill_values[name] = fill_value(dtype)
+
+        self.n_rows = 0
+        self.n_rows_written = 0
+
+    def append(self, *values):
+        '''Append a row, taking the values of the columns from the
+        given dicts, later dicts take precedence.
+        Columns not found in any of them are filled with NaN or -1.
+        '''
+        row = self.n_rows
+        for name, column in self.columns.items():
+            for d in reversed(values):
+                if name in d:
+                    column[row] = d[name]
+                    break
+            else:
+                column[row] = self.fill_values[name]
+        self.commit()
+
+    def commit(self):
+        '''Finish a row that was directly written into
+        the columns at index `n_rows`'''
+        self.n_rows += 1
+        if self.n_rows == self.batch_size:
+            self.flush()
+
+    def flush(self):
+        if self.n_rows == 0:
+            return
+
+        self.writer.write_batch(
+            self.table,
+            {name: column[:self.n_rows] for name, column in self.columns.items()}
+        )
+        self.n_rows_written += self.n_rows
+        self.n_rows = 0
+
+
+class ArrowWriter:
+    '''
+    Write tables as parquet or arrow ipc files into `directory`,
+    one file per table named ``<table>.parquet`` or ``<table>.arrow``,
+    slashes in table names are replaced by underscores.
+
+    Columns with multidimensional values are stored as fixed size lists
+    of the flattened values, the shape of a value is stored in
+    the field metadata under ``shape``.
+    '''
+    def __init__(self, directory, format='parquet', compression='zstd'):
+        try:
+            import pyarrow
+        except ImportError:
+            raise IOError(
+                'You need to install the `pyarrow` module '
+                'to export to {} files'.format(format)
+            )
+
+        if format not in ('parquet', 'arrow'):
+            raise ValueError('Unknown arrow format {}'.format(format))
+
+        self.pa = pyarrow
+        self.directory = directory
+        self.format = format
+        self.compression = compression
+        self._writers = {}
+        os.makedirs(directory, exist_ok=True)
+
+    def path(self, table):
+        return os.path.join(
+            self.directory, '{}.{}'.format(table.replace('/', '_'), self.format)
+        )
+
+    def _to_arrow(self, name, column):
+        pa = self.pa
+        if column.ndim == 1:
+            array = pa.array(column)
+            return pa.field(name, array.type), array
+
+        shape = column.shape[1:]
+        values = pa.array(column.reshape(-1))
+        array = pa.FixedSizeListArray.from_arrays(values, int(np.prod(shape)))
+        metadata = {'shape': ','.join(map(str, shape))}
+        return pa.field(name, array.type, metadata=metadata), array
+
+    def _open(self, table, schema):
+        path = self.path(table)
+        if self.format == 'parquet':
+            import pyarrow.parquet as pq
+            return pq.ParquetWriter(path, schema, compression=self.compression)
+        return self.pa.ipc.new_file(path, schema)
+
+    def write_batch(self, table, columns):
+        fields, arrays = zip(*(
+            self._to_arrow(name, column) for name, column in columns.items()
+        ))
+        schema = self.pa.schema(fields)
+        batch = self.pa.RecordBatch.from_arrays(list(arrays), schema=schema)
+
+        writer = self._writers.get(table)
+        if writer is None:
+            writer = self._writers[table] = self._open(table, schema)
+
+        if self.format == 'parquet':
+            writer.write_table(self.pa.Table.from_batches([batch]))
+        else:
+            writer.write_batch(batch)
+
+    def close(self):
+        for writer in self._writers.values():
+            writer.close()
+        self._writers.clear()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+
+class HDF5Writer:
+    '''
+    Write tables into an HDF5 file, each table is a group
+    with one resizable, chunked dataset per column.
+    '''
+    def __init__(self, path, compression='gzip'):
+        try:
+            import h5py
+        except ImportError:
+            raise IOError(
+                'You need to install the `h5py` module to export to hdf5 files'
+            )
+
+        self.path = path
+        self.compression = compression
+        self._file = h5py.File(path, 'w')
+
+    def write_batch(self, table, columns):
+        group = self._file.require_group(table)
+
+        for name, column in columns.items():
+            if name not in group:
+                # one chunk per batch for scalar columns,
+                # one chunk per row for e.g. waveforms
+                chunk_rows = len(column) if column.ndim == 1 else 1
+                group.create_dataset(
+                    name,
+                    data=column,
+                    maxshape=(None, ) + column.shape[1:],
+                    chunks=(chunk_rows, ) + column.shape[1:],
+                    compression=self.compression,
+                )
+                continue
+
+            dataset = group[name]
+            n_rows = len(dataset)
+            dataset.resize(n_rows + len(column), axis=0)
+            dataset[n_rows:] = column
+
+    def close(self):
+        self._file.close()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+
+def _open_writer(output, format):
+    if format is None:
+        format = 'hdf5' if str(output).endswith(('.h5', '.hdf5')) else 'parquet'
+
+    if format == 'hdf5':
+        return HDF5Writer(output)
+    if format in ('parquet', 'arrow'):
+        return ArrowWriter(output, format=format)
+    raise ValueError('Unknown export format {}'.format(format))
+
+
+def _trigger_times(trigger_information):
+    cpu_time = trigger_information['cpu_time']
+    gps_time = trigger_information['gps_time']
+    return {
+        'cpu_time_s': cpu_time[0],
+        'cpu_time_ns': cpu_time[1],
+        'gps_time_s': gps_time[0],
+        'gps_time_ns': gps_time[1],
+    }
+
+
+def export_simtel(
+    path,
+    output,
+    format=None,
+    waveforms=False,
+    batch_size=DEFAULT_BATCH_SIZE,
+    waveform_batch_size=DEFAULT_WAVEFORM_BATCH_SIZE,
+    allowed_telescopes=None,
+    **kwargs
+):
+    '''Export the events of the simtel file at `path` to columnar files.
+
+    Parameters
+    ----------
+    path: str
+        The simtel file
+    output: str
+        For parquet and arrow, the directory the tables are written to,
+        for hdf5 the output file
+    format: str or None
+        One of "parquet", "arrow" or "hdf5".
+        If None, hdf5 is used if `output` ends with ".h5" or ".hdf5",
+        parquet otherwise.
+    waveforms: bool
+        If True, also export the adc samples of all telescope events
+    batch_size: int
+        Number of rows per batch of the events and telescope events tables
+    waveform_batch_size: int
+        Number of rows per batch of the waveform tables
+    allowed_telescopes: iterable[int] or None
+        Only export the data of these telescopes
+    **kwargs:
+        Passed to `SimTelFile`
+
+    Returns
+    -------
+    n_events: int
+        Number of exported array events
+    '''
+    writer = _open_writer(output, format)
+
+    with writer, SimTelFile(
+        path,
+        allowed_telescopes=allowed_telescopes,
+        lazy_telescope_events=True,
+        skip_calibration=True,
+        **kwargs
+    ) as f:
+        events = ColumnBuffer(writer, 'events', EVENT_COLUMNS, batch_size)
+        telescope_events = ColumnBuffer(
+            writer, 'telescope_events', TELESCOPE_EVENT_COLUMNS, batch_size
+        )
+        waveform_buffers = {}
+        buffers = [events, telescope_events]
+
+        for event in f:
+            if event['type'] != 'data':
+                continue
+
+            event_id = event['event_id']
+            trigger_information = event['trigger_information']
+            events.append(
+                event['mc_shower'] or {},
+                event['mc_event'] or {},
+                trigger_information,
+                _trigger_times(trigger_information),
+                {'event_id': event_id},
+            )
+
+            for telescope_id, telescope_event in event['telescope_events'].items():
+                image_parameters = {}
+                if 'image_parameters' in telescope_event:
+                    image_parameters = telescope_event['image_parameters']
+                telescope_events.append(
+                    image_parameters, {'event_id': event_id, 'telescope_id': telescope_id},
+                )
+
+                if not waveforms or 'adc_samples' not in telescope_event:
+                    continue
+
+                adc_samples = telescope_event.get_object('adc_samples')
+                shape = adc_samples.shape
+
+                buffer = waveform_buffers.get(telescope_id)
+                if buffer is None:
+                    buffer = waveform_buffers[telescope_id] = ColumnBuffer(
+                        writer,
+                        'waveforms/tel_{:03d}'.format(telescope_id),
+                        [('event_id', np.int64), ('waveforms', np.uint16, shape)],
+                        waveform_batch_size,
+                    )
+                    buffers.append(buffer)
+                elif buffer.columns['waveforms'].shape[1:] != shape:
+                    raise ValueError(
+                        'Shape of adc samples of telescope {} changed from {} to {}'.format(
+                            telescope_id, buffer.columns['waveforms'].shape[1:], shape,
+                        )
+                    )
+
+                row = buffer.n_rows
+                buffer.columns['event_id'][row] = event_id
+                adc_samples.parse_into(buffer.columns['waveforms'][row])
+                buffer.commit()
+
+        for buffer in buffers:
+            buffer.flush()
+
+    return events.n_rows_written
@@ -0,0 +1,225 @@
+# cython: language_level=3
+'''
+Decoders for the telescope event data using the ``IO_BUFFER`` routines
+of the hessioxxx library, see ``SimTelFile(engine='hessio')``.
+
+The routines are extracted from ``hessioxxx-20181107/eventio.c`` when
+building with the environment variable ``EVENTIO_BUILD_HESSIO=1``.
+The functions here follow ``read_hess_teladc_samples`` and
+``read_hess_teladc_sums`` of ``io_hess.c`` and return the same arrays
+as the default decoders in `eventio.simtel.parsing`.
+'''
+import cython
+from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t, int16_t, int32_t, int64_t
+from libc.string cimport memset
+import numpy as np
+from eventio.var_int_kernels cimport (
+    STATUS_OK,
+    STATUS_BUFFER_OVERRUN,
+    STATUS_INDEX_OUT_OF_RANGE,
+    buffer_pointer,
+    check_status,
+    read_int16,
+    read_int32,
+)
+
+
+cdef extern from "hessio_kernels.h" nogil:
+    ctypedef unsigned char BYTE
+    ctypedef struct IO_BUFFER:
+        BYTE* data
+        long r_remaining
+
+    int64_t get_scount(IO_BUFFER* iobuf)
+    int32_t get_scount32(IO_BUFFER* iobuf)
+    void get_vector_of_uint16_scount_differential(uint16_t* vec, int num, IO_BUFFER* iobuf)
+    void get_vector_of_uint32_scount_differential(uint32_t* vec, int num, IO_BUFFER* iobuf)
+
+
+cdef enum:
+    # the optimized vector routines only check the buffer after decoding,
+    # a single value, valid or not, takes at most 9 bytes
+    MAX_VALUE_SIZE = 9
+
+
+cdef inline void get_samples(uint16_t* vec, int num, IO_BUFFER* iobuf) nogil:
+    cdef int i
+    cdef int32_t val = 0
+    if iobuf.r_remaining >= <long> num * MAX_VALUE_SIZE:
+        get_vector_of_uint16_scount_differential(vec, num, iobuf)
+        return
+
+    # near the end of the buffer, use the generic version,
+    # which checks each byte
+    for i in range(num):
+        val += get_scount32(iobuf)
+        vec[i] = <uint16_t> val
+
+
+cdef inline void get_sums(uint32_t* vec, int num, IO_BUFFER* iobuf) nogil:
+    cdef int i
+    cdef int32_t val = 0
+    if iobuf.r_remaining >= <long> num * MAX_VALUE_SIZE:
+        get_vector_of_uint32_scount_differential(vec, num, iobuf)
+        return
+
+    for i in range(num):
+        val += get_scount32(iobuf)
+        vec[i] = <uint32_t> val
+
+
+cdef int decode_adc_samples(
+    IO_BUFFER* iobuf,
+    bint zero_suppressed,
+    uint16_t* output,
+    int32_t n_gains,
+    int32_t n_pixels,
+    int32_t n_samples,
+) nogil:
+    cdef int32_t i_gain, i_list, list_size
+    cdef int64_t i, i_pixel, first, last
+    cdef BYTE* list_start
+    cdef IO_BUFFER pixel_list
+
+    if not zero_suppressed:
+        for i in range(<int64_t> n_gains * n_pixels):
+            get_samples(output + <uint64_t> i * n_samples, n_samples, iobuf)
+            if iobuf.r_remaining < 0:
+                return STATUS_BUFFER_OVERRUN
+        return STATUS_OK
+
+    if output != NULL:
+        memset(output, 0, <uint64_t> n_gains * n_pixels * n_samples * sizeof(uint16_t))
+
+    list_size = get_scount32(iobuf)
+    if list_size < 0 or list_size > n_pixels:
+        return STATUS_INDEX_OUT_OF_RANGE
+
+    # validate the pixel list once, it is read again for each gain
+    list_start = iobuf.data
+    for i_list in range(list_size):
+        first = get_scount(iobuf)
+        if first < 0:
+            last = -first - 1
+            first = last
+        else:
+            last = get_scount(iobuf)
+        if iobuf.r_remaining < 0:
+            return STATUS_BUFFER_OVERRUN
+        if first < 0 or last < first or last >= n_pixels:
+            return STATUS_INDEX_OUT_OF_RANGE
+
+    for i_gain in range(n_gains):
+        pixel_list.data = list_start
+        pixel_list.r_remaining = iobuf.data - list_start
+        for i_list in range(list_size):
+            first = get_scount(&pixel_list)
+            if first < 0:
+                last = -first - 1
+                first = last
+            else:
+                last = get_scount(&pixel_list)
+
+            for i_pixel in range(first, last + 1):
+                get_samples(
+                    output + (<uint64_t> i_gain * n_pixels + i_pixel) * n_samples,
+                    n_samples,
+                    iobuf,
+                )
+                if iobuf.r_remaining < 0:
+                    return STATUS_BUFFER_OVERRUN
+
+    return STATUS_OK
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def parse_adc_samples(const uint8_t[::1] data, bint zero_suppressed, output=None):
+    '''Decode the payload of an ADCSamples object (version 3, data_red_mode 0,
+    no known list) into a uint16 array of shape (n_gains, n_pixels, n_samples).
+
+    Same interface as `eventio.simtel.parsing.parse_adc_samples`.
+    '''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef uint64_t pos = 0
+    cdef int32_t n_pixels
+    cdef int16_t n_gains, n_samples
+    cdef int status = STATUS_OK
+    cdef uint16_t[:, :, ::1] output_view
+    cdef uint16_t* output_ptr = NULL
+    cdef IO_BUFFER iobuf
+
+    check_status(read_int32(ptr, size, &pos, &n_pixels))
+    check_status(read_int16(ptr, size, &pos, &n_gains))
+    check_status(read_int16(ptr, size, &pos, &n_samples))
+
+    if n_pixels < 0 or n_gains < 0 or n_samples < 0:
+        raise ValueError('Invalid ADCSamples shape ({}, {}, {})'.format(
+            n_gains, n_pixels, n_samples
+        ))
+
+    shape = (n_gains, n_pixels, n_samples)
+    if output is None:
+        output = np.empty(shape, dtype=np.uint16)
+    elif output.shape != shape:
+        raise ValueError('Output has shape {}, but data has shape {}'.format(
+            output.shape, shape
+        ))
+
+    output_view = output
+    if output.size > 0:
+        output_ptr = &output_view[0, 0, 0]
+
+    # the hessio routines take a non-const buffer, but never write to it
+    iobuf.data = <BYTE*> ptr + pos
+    iobuf.r_remaining = size - pos
+    with nogil:
+        status = decode_adc_samples(
+            &iobuf, zero_suppressed, output_ptr, n_gains, n_pixels, n_samples,
+        )
+
+    check_status(status)
+    return output, size - iobuf.r_remaining
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def parse_adc_sums(const uint8_t[::1] data):
+    '''Decode the payload of an ADCSums object without zero suppression
+    (version 3, data_red_mode 0, zero_sup_mode 0)
+    into a uint32 array of shape (n_gains, n_pixels).
+
+    Returns
+    -------
+    adc_sums: np.ndarray[uint32]
+    bytes_read: int
+    '''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef uint64_t pos = 0
+    cdef int32_t n_pixels
+    cdef int16_t n_gains
+    cdef int16_t i_gain
+    cdef uint32_t[:, ::1] output_view
+    cdef IO_BUFFER iobuf
+
+    check_status(read_int32(ptr, size, &pos, &n_pixels))
+    check_status(read_int16(ptr, size, &pos, &n_gains))
+
+    if n_pixels < 0 or n_gains < 0:
+        raise ValueError('Invalid ADCSums shape ({}, {})'.format(n_gains, n_pixels))
+
+    output = np.empty((n_gains, n_pixels), dtype=np.uint32)
+    output_view = output
+
+    iobuf.data = <BYTE*> ptr + pos
+    iobuf.r_remaining = size - pos
+    if n_pixels > 0:
+        with nogil:
+            for i_gain in range(n_gains):
+                get_sums(&output_view[i_gain, 0], n_pixels, &iobuf)
+
+    if iobuf.r_remaining < 0:
+        check_status(STATUS_BUFFER_OVERRUN)
+    return output, size - iobuf.r_remaining
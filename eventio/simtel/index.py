@@ -0,0 +1,156 @@
+'''
+Event based view of an `EventIOIndex` of a simtel file,
+used for random access to array events.
+'''
+import numpy as np
+
+from ..base import KNOWN_OBJECTS
+from .. import iact
+from .objects import (
+    ArrayEvent,
+    CameraMonitoring,
+    LaserCalibration,
+    MCEvent,
+    MCShower,
+    TelescopeEvent,
+)
+
+
+EVENT_TABLE_DTYPE = np.dtype([
+    ('event_id', 'u4'),
+    ('shower_id', 'u4'),
+    # toplevel object offsets, -1 if the event has no such object
+    ('mc_shower', 'i8'),
+    ('mc_event', 'i8'),
+    ('telescope_data', 'i8'),
+    ('array_event', 'i8'),
+])
+
+
+def _match_preceding(offsets, ids, candidate_offsets, candidate_ids=None):
+    '''For each offset, find the offset of the last candidate before it,
+    optionally requiring the same id, -1 if there is no such candidate.
+    '''
+    idx = np.searchsorted(candidate_offsets, offsets) - 1
+    valid = idx >= 0
+    result = np.full(len(offsets), -1, dtype=np.int64)
+    result[valid] = candidate_offsets[idx[valid]]
+
+    if candidate_ids is not None:
+        valid[valid] = candidate_ids[idx[valid]] == ids[valid]
+        result[~valid] = -1
+
+    return result, idx
+
+
+def build_event_table(toplevel):
+    '''Associate each ArrayEvent with the MCShower, MCEvent and
+    TelescopeData objects in front of it.'''
+    def select(eventio_type):
+        rows = toplevel[toplevel['type'] == eventio_type]
+        return rows['offset'].astype(np.int64), rows['id']
+
+    array_offsets, event_ids = select(ArrayEvent.eventio_type)
+    shower_offsets, shower_ids = select(MCShower.eventio_type)
+    mc_event_offsets, mc_event_ids = select(MCEvent.eventio_type)
+    telescope_data_offsets, telescope_data_ids = select(iact.TelescopeData.eventio_type)
+
+    events = np.zeros(len(array_offsets), dtype=EVENT_TABLE_DTYPE)
+    events['event_id'] = event_ids
+    events['array_event'] = array_offsets
+
+    events['mc_shower'], idx = _match_preceding(array_offsets, event_ids, shower_offsets)
+    has_shower = events['mc_shower'] >= 0
+    events['shower_id'][has_shower] = shower_ids[idx[has_shower]]
+
+    events['mc_event'], _ = _match_preceding(
+        array_offsets, event_ids, mc_event_offsets, mc_event_ids
+    )
+    events['telescope_data'], _ = _match_preceding(
+        array_offsets, event_ids, telescope_data_offsets, telescope_data_ids
+    )
+
+    # mc information of a previous shower does not belong to this event
+    for col in ('mc_event', 'telescope_data'):
+        events[col][events[col] < events['mc_shower']] = -1
+
+    return events
+
+
+class SimTelEventIndex:
+    '''
+    Random access information for the array events of a simtel file.
+
+    Attributes
+    ----------
+    index: EventIOIndex
+        The underlying object index, needs at least max_depth=1
+        for `telescope_events`.
+    events: np.ndarray[EVENT_TABLE_DTYPE]
+        One row per ArrayEvent in file order
+    '''
+    def __init__(self, index):
+        self.index = index
+        self.toplevel = index.toplevel
+        self.events = build_event_table(self.toplevel)
+
+        self._rows = {}
+        for row, event_id in enumerate(self.events['event_id'].tolist()):
+            self._rows.setdefault(event_id, row)
+
+        self.shower_offsets = {}
+        showers = self.toplevel[self.toplevel['type'] == MCShower.eventio_type]
+        for shower_id, offset in zip(showers['id'].tolist(), showers['offset'].tolist()):
+            self.shower_offsets.setdefault(shower_id, offset)
+
+        is_monitoring = np.isin(
+            self.toplevel['type'],
+            [CameraMonitoring.eventio_type, LaserCalibration.eventio_type],
+        )
+        self._monitoring = self.toplevel[is_monitoring]
+
+    def __len__(self):
+        return len(self.events)
+
+    def __contains__(self, event_id):
+        return event_id in self._rows
+
+    def __getitem__(self, event_id):
+        try:
+            return self.events[self._rows[event_id]]
+        except KeyError:
+            raise KeyError('Event {} not in file'.format(event_id)) from None
+
+    @property
+    def event_ids(self):
+        return self.events['event_id']
+
+    def event_start(self, event_id):
+        '''Offset of the first toplevel object belonging to event `event_id`'''
+        event = self[event_id]
+        offsets = [
+            int(event[col]) for col in ('mc_event', 'telescope_data', 'array_event')
+            if event[col] >= 0
+        ]
+        return min(offsets)
+
+    def monitoring_offsets(self, offset):
+        '''Offsets of the last CameraMonitoring and LaserCalibration per telescope
+        in front of `offset`, keyed by (type, header id)'''
+        rows = self._monitoring[self._monitoring['offset'] < offset]
+        # later objects overwrite earlier ones
+        return dict(zip(
+            zip(rows['type'].tolist(), rows['id'].tolist()),
+            rows['offset'].tolist(),
+        ))
+
+    def telescope_events(self, event_id):
+        '''Offsets of the TelescopeEvents in event `event_id` by telescope id'''
+        offset = int(self[event_id]['array_event'])
+        telescope_events = {}
+        for row in self.index.subobjects(offset):
+            cls = KNOWN_OBJECTS.get(int(row['type']))
+            if cls is TelescopeEvent:
+                telescope_id = TelescopeEvent.type_to_telid(int(row['type']))
+                telescope_events[telescope_id] = int(row['offset'])
+        return telescope_events
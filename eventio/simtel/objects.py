@@ -14,17 +14,16 @@ from ..tools import (
     read_array,
     read_time,
 )
-from ..header import bool_bit_from_pos
 from ..var_int import (
     unsigned_varint_arrays_differential,
     varint_array,
-    varint,
 )
 from ..version_handling import (
     assert_exact_version,
     assert_max_version,
     assert_version_in
 )
+from .engines import load_engine
 
 
 def read_remaining_with_check(byte_stream, length):
@@ -35,14 +34,27 @@ def read_remaining_with_check(byte_stream, length):
     return data
 
 
+def view_remaining_with_check(eventio_object):
+    '''Like `read_remaining_with_check` but returns a memoryview
+    of the remaining payload of `eventio_object` without copying it
+    if the file supports this.
+    '''
+    pos = eventio_object.tell()
+    data = eventio_object.view()
+    if len(data) < (eventio_object.size - pos):
+        raise EOFError('File seems to be truncated')
+    return data
+
+
 class TelescopeObject(EventIOObject):
     '''
     BaseClass that reads telescope id from header.id and puts it in repr
     '''
+    __slots__ = ()
 
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
-        self.telescope_id = header.id
+    @property
+    def telescope_id(self):
+        return self.header.id
 
     def __str__(self):
         return '{}[{}](telescope_id={})'.format(
@@ -230,6 +242,9 @@ class CameraSettings(TelescopeObject):
 
 
 class CameraOrganization(TelescopeObject):
+    '''The trigger sectors of each pixel are stored in CSR format:
+    the sectors of pixel i are ``sector_indices[sector_offsets[i]:sector_offsets[i + 1]]``,
+    ``sectors`` is a lazy list view of these arrays.'''
     eventio_type = 2003
 
     from .parsing import read_sector_information_v1
@@ -291,6 +306,8 @@ class CameraOrganization(TelescopeObject):
             'chip': chip,
             'channel': channel,
             'sectors': sectors,
+            'sector_offsets': sectors.offsets,
+            'sector_indices': sectors.values,
             'sector_type': sector_data['type'],
             'sector_threshold': sector_data['threshold'],
             'sector_pixel_threshold': sector_data['pixel_threshold'],
@@ -355,6 +372,8 @@ class CameraOrganization(TelescopeObject):
             'chip': chip,
             'channel': channel,
             'sectors': sectors,
+            'sector_offsets': sectors.offsets,
+            'sector_indices': sectors.values,
             'sector_type': sector_data['type'],
             'sector_threshold': sector_data['threshold'],
             'sector_pixel_threshold': sector_data['pixel_threshold'],
@@ -521,10 +540,12 @@ class DriveSettings(TelescopeObject):
 
 class TriggerInformation(EventIOObject):
     eventio_type = 2009
+    __slots__ = ()
+    from .parsing import parse_trigger_information
 
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
-        self.global_count = self.header.id
+    @property
+    def global_count(self):
+        return self.header.id
 
     def __str__(self):
         return '{}[{}](event_id={})'.format(
@@ -535,61 +556,10 @@ class TriggerInformation(EventIOObject):
 
     def parse(self):
         assert_max_version(self, 3)
-
         self.seek(0)
-        byte_stream = BytesIO(self.read())
-
-        event_info = {}
-        event_info['cpu_time'] = read_time(byte_stream)
-        event_info['gps_time'] = read_time(byte_stream)
-        event_info['trigger_pattern'] = read_int(byte_stream)
-        event_info['data_pattern'] = read_int(byte_stream)
-
-        version = self.header.version
-        if version >= 1:
-            tels_trigger = read_short(byte_stream)
-            event_info['n_triggered_telescopes'] = tels_trigger
-
-            event_info['triggered_telescopes'] = read_array(
-                byte_stream, count=tels_trigger, dtype='<i2',
-            )
-            event_info['trigger_times'] = read_array(
-                byte_stream, count=tels_trigger, dtype='<f4',
-            )
-            tels_data = read_short(byte_stream)
-            event_info['n_telescopes_with_data'] = tels_data
-            event_info['telescopes_with_data'] = read_array(
-                byte_stream, count=tels_data, dtype='<i2'
-            )
-
-        if version >= 2:
-            # konrad saves the trigger mask as crazy int, but it uses only 4 bits
-            # so it should be indentical to a normal unsigned int with 1 byte
-            event_info['teltrg_type_mask'] = read_array(
-                byte_stream, count=tels_trigger, dtype='uint8'
-            )
-            assert np.all(event_info['teltrg_type_mask'] < 128), 'Unexpected trigger mask'
-
-            event_info['teltrg_time_by_type'] = {}
-            it = zip(event_info['triggered_telescopes'], event_info['teltrg_type_mask'])
-            for tel_id, mask in it:
-                # trigger times are only written if more than one trigger is there
-                if mask not in {0b001, 0b010, 0b100}:
-                    event_info['teltrg_time_by_type'][tel_id] = {}
-                    for trigger in range(3):
-                        if bool_bit_from_pos(mask, trigger):
-                            t = read_float(byte_stream)
-                            event_info['teltrg_time_by_type'][tel_id][trigger] = t
-
-        if version >= 3:
-            # information about "plane wavefront compensation"
-            comp = {}
-            comp['az'] = read_float(byte_stream)
-            comp['alt'] = read_float(byte_stream)
-            comp['speed_of_light'] = read_float(byte_stream)
-            event_info['plane_wavefront_compensation'] = comp
-
-        return event_info
+        return TriggerInformation.parse_trigger_information(
+            view_remaining_with_check(self), self.header.version,
+        )
 
 
 class TrackingPosition(EventIOObject):
@@ -601,29 +571,48 @@ class TrackingPosition(EventIOObject):
     So a container with type 2105 belongs to tel_id 5, 3105 to 105
     '''
     eventio_type = None
+    __slots__ = ()
+
+    # the layout only depends on (has_raw, has_cor)
+    dtypes = {
+        (has_raw, has_cor): np.dtype(
+            [('azimuth_raw', '<f4'), ('altitude_raw', '<f4')] * has_raw
+            + [('azimuth_cor', '<f4'), ('altitude_cor', '<f4')] * has_cor
+        )
+        for has_raw in (False, True)
+        for has_cor in (False, True)
+    }
 
     def __init__(self, header, filehandle):
-        self.eventio_type = header.type
         super().__init__(header, filehandle)
-        self.telescope_id = self.type_to_telid(header.type)
-        if not self.id_to_telid(header.id) == self.telescope_id:
+        if self.id_to_telid(header.id) != self.type_to_telid(header.type):
             raise ValueError('Telescope IDs in type and header do not match')
 
-        self.has_raw = bool(header.id & 0x100)
-        self.has_cor = bool(header.id & 0x200)
+    @property
+    def telescope_id(self):
+        return self.type_to_telid(self.header.type)
+
+    @property
+    def has_raw(self):
+        return bool(self.header.id & 0x100)
+
+    @property
+    def has_cor(self):
+        return bool(self.header.id & 0x200)
 
     def parse(self):
         assert_exact_version(self, 0)
         self.seek(0)
-        byte_stream = BytesIO(self.read())
 
-        dt = []
-        if self.has_raw:
-            dt.extend([('azimuth_raw', '<f4'), ('altitude_raw', '<f4')])
-        if self.has_cor:
-            dt.extend([('azimuth_cor', '<f4'), ('altitude_cor', '<f4')])
-        A = read_array(byte_stream, count=1, dtype=dt)[0]
-        D = merge_structured_arrays_into_dict([A])
+        dtype = TrackingPosition.dtypes[self.has_raw, self.has_cor]
+        data = self.read(dtype.itemsize)
+        if len(data) < dtype.itemsize:
+            raise EOFError('File seems to be truncated')
+
+        D = {}
+        if dtype.names:
+            record = np.frombuffer(data, dtype=dtype, count=1)[0]
+            D = {name: record[name] for name in dtype.names}
         D['telescope_id'] = self.telescope_id
         return D
 
@@ -644,7 +633,7 @@ class TrackingPosition(EventIOObject):
     def __str__(self):
         return '{}[{}](telescope_id={})'.format(
             self.__class__.__name__,
-            self.eventio_type,
+            self.header.type,
             self.telescope_id,
         )
 
@@ -658,12 +647,15 @@ class TelescopeEvent(EventIOObject):
     So a container with type 2205 belongs to tel_id 5, 3205 to 105
     '''
     eventio_type = None
+    __slots__ = ()
 
-    def __init__(self, header, filehandle):
-        self.eventio_type = header.type
-        super().__init__(header, filehandle)
-        self.telescope_id = self.type_to_telid(header.type)
-        self.global_count = header.id
+    @property
+    def telescope_id(self):
+        return self.type_to_telid(self.header.type)
+
+    @property
+    def global_count(self):
+        return self.header.id
 
     @staticmethod
     def type_to_telid(eventio_type):
@@ -677,17 +669,18 @@ class TelescopeEvent(EventIOObject):
     def __str__(self):
         return '{}[{}](telescope_id={})'.format(
             self.__class__.__name__,
-            self.eventio_type,
+            self.header.type,
             self.telescope_id,
         )
 
 
 class ArrayEvent(EventIOObject):
     eventio_type = 2010
+    __slots__ = ()
 
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
-        self.event_id = header.id
+    @property
+    def event_id(self):
+        return self.header.id
 
     def __str__(self):
         return '{}[{}](event_id={})'.format(
@@ -699,6 +692,8 @@ class ArrayEvent(EventIOObject):
 
 class TelescopeEventHeader(TelescopeObject):
     eventio_type = 2011
+    __slots__ = ()
+    from .parsing import parse_telescope_event_header
 
     def __str__(self):
         return '{}[{}](telescope_id={})'.format(
@@ -710,96 +705,22 @@ class TelescopeEventHeader(TelescopeObject):
     def parse(self):
         assert_max_version(self, 3)
         self.seek(0)
-        byte_stream = BytesIO(self.read())
-
-        event_head = {}
-        event_head['loc_count'] = read_int(byte_stream)
-        event_head['glob_count'] = read_int(byte_stream)
-        event_head['cpu_time'] = read_time(byte_stream)
-        event_head['gps_time'] = read_time(byte_stream)
-        t = read_short(byte_stream)
-        event_head['trg_source'] = t & 0xff
-
-        pos = 0
-        data = read_remaining_with_check(byte_stream, self.header.content_size)
-        if t & 0x100:
-            if self.header.version <= 1:
-                n_list_trgsect, = struct.unpack('<h', data[pos:pos + 2])
-                pos += 2
-                event_head['list_trgsect'] = np.frombuffer(
-                    data, dtype='<i2', count=n_list_trgsect, offset=pos,
-                )
-                pos += n_list_trgsect * 2
-            else:
-                n_list_trgsect, length = varint(data, offset=pos)
-                pos += length
-                event_head['list_trgsect'], length = varint_array(
-                    data, n_elements=n_list_trgsect, offset=pos,
-                )
-                pos += length
-            if self.header.version >= 1 and (t & 0x400):
-                event_head['time_trgsect'] = np.frombuffer(
-                    data, dtype='<f4', count=n_list_trgsect, offset=pos
-                )
-                pos += 4 * n_list_trgsect
-
-        if t & 0x200:
-            if self.header.version <= 1:
-                event_head['n_phys_addr'] = struct.unpack('<h', data[pos:pos + 2])
-                pos += 2
-                event_head['phys_addr'] = np.frombuffer(
-                    data, dtype='<i2', count=event_head['n_phys_addr'], offset=pos
-                )
-                pos += 2 * event_head['n_phys_addr']
-            else:
-                event_head['n_phys_addr'], length = varint(data, offset=pos)
-                pos += length
-                event_head['phys_addr'], length = varint_array(
-                    data, n_elements=event_head['n_phys_addr'], offset=pos
-                )
-                pos += length
-
-        if self.header.version >= 3:
-            times = struct.unpack('ff', data[pos:pos + 8])
-            pos += 8
-            event_head['readout_time'], event_head['relative_trigger_time'] = times
-
-        event_head['telescope_id'] = self.header.id
-        return event_head
-
-
-def number_of_bits_in(n):
-    m = 0
-    for i in range(16):
-        if n & (1 << i):
-            m += 1
-    return m
-
-
-def make_ks_n_ns(n_pixels):
-    N, mod = divmod(n_pixels, 16)
-    if mod == 0:
-        ns = np.ones(N, dtype='u4') * 16
-    else:
-        ns = np.ones(N + 1, dtype='u4') * 16
-        ns[-1] = mod
-    assert np.sum(ns) == n_pixels
-
-    ks = np.cumsum(ns).astype('u4')
-    return ns, ks
+        return TelescopeEventHeader.parse_telescope_event_header(
+            view_remaining_with_check(self), self.header.version, self.header.id,
+        )
 
 
 class ADCSums(EventIOObject):
     eventio_type = 2012
     LO_GAIN = 1
     HI_GAIN = 0
+    __slots__ = ()
 
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
+    @property
+    def telescope_id(self):
         if self.header.version <= 1:
-            self.telescope_id = (header.id >> 25) & 0x1f
-        else:
-            self.telescope_id = (header.id >> 12) & 0xffff
+            return (self.header.id >> 25) & 0x1f
+        return (self.header.id >> 12) & 0xffff
 
     def __str__(self):
         return '{}[{}](telescope_id={})'.format(
@@ -808,128 +729,50 @@ class ADCSums(EventIOObject):
             self.telescope_id,
         )
 
-    def parse(self):
+    @property
+    def instrumentation_variant(self):
+        return 'zero_sup_mode={}'.format(self.header.id & 0x1f)
+
+    from .parsing import parse_adc_sums_zero_suppressed as _parse_zero_suppressed
+
+    def parse(self, engine='cython'):
+        '''
+        Parameters
+        ----------
+        engine: str
+            Decoders to use, see `eventio.simtel.engines`.
+            Zero suppressed data is always decoded by the default decoders.
+        '''
         assert_exact_version(self, 3)
         self.seek(0)
-        byte_stream = BytesIO(self.read())
 
         flags = self.header.id
         raw = {'telescope_id': self.telescope_id}
         raw['zero_sup_mode'] = flags & 0x1f
         raw['data_red_mode'] = (flags >> 5) & 0x1f
         raw['list_known'] = (flags >> 10) & 0x01
-        n_pixels = read_int(byte_stream)
-        n_gains = read_short(byte_stream)
 
         if raw['data_red_mode'] == 0 and raw['zero_sup_mode'] == 0:
-            raw['adc_sums'] = []
-            data = read_remaining_with_check(byte_stream, self.header.content_size)
-            raw['adc_sums'], bytes_read = unsigned_varint_arrays_differential(
-                data, n_arrays=n_gains, n_elements=n_pixels
-            )
-
-            try:
-                return np.squeeze(raw['adc_sums'], axis=-1)
-            except ValueError:
-                return raw['adc_sums']
-
-        if raw['data_red_mode'] == 0 and raw['zero_sup_mode'] == 1:
-            ns, ks = make_ks_n_ns(n_pixels)
-            adc_sums = np.zeros((n_gains, n_pixels), dtype='f8')
-            raw['adc_sums'] = adc_sums
-
-            data = read_remaining_with_check(byte_stream, self.header.content_size)
-            pos = 0
-            for n, k in zip(ns, ks):
-                zbits, = struct.unpack('<h', data[pos:pos + 2])
-                pos += 2
-                m = number_of_bits_in(zbits)
-                mlg = m
-                mhg16 = m
-                bytes_read = 0
-                lgval = None
-                if n_gains == 2:
-                    # get_vector_of_uint32_scount_differential(lgval,mlg,iobuf);
-                    lgval, bytes_read = unsigned_varint_arrays_differential(
-                        data[pos:], n_arrays=1, n_elements=mlg
-                    )
-                    lgval = lgval[0]
-                    pos += bytes_read
-
-                # get_vector_of_uint32_scount_differential(hgval,mhg16,iobuf);
-                hgval, bytes_read = unsigned_varint_arrays_differential(
-                    data[pos:], n_arrays=1, n_elements=mhg16
+            data = view_remaining_with_check(self)
+            hessio = load_engine(engine)
+            if hessio is not None:
+                raw['adc_sums'], bytes_read = hessio.parse_adc_sums(data)
+            else:
+                n_pixels, n_gains = struct.unpack_from('<ih', data, 0)
+                raw['adc_sums'], bytes_read = unsigned_varint_arrays_differential(
+                    data, n_arrays=n_gains, n_elements=n_pixels, offset=6,
                 )
-                hgval = hgval[0]
-                pos += bytes_read
-
-                mlg, mhg16, m = 0, 0, 0
-                for j in range(n):
-                    if zbits & (1 << j):
-                        if lgval is not None:
-                            adc_sums[ADCSums.LO_GAIN, k - n + j] = lgval[mlg]
-                            mlg += 1
-                        adc_sums[ADCSums.HI_GAIN, k - n + j] = hgval[mhg16]
-                        mhg16 += 1
 
             try:
                 return np.squeeze(raw['adc_sums'], axis=-1)
             except ValueError:
                 return raw['adc_sums']
 
-        if raw['data_red_mode'] == 0 and raw['zero_sup_mode'] == 2:
-            adc_sums = np.zeros((n_gains, n_pixels), dtype='f8')
-            raw['adc_sums'] = adc_sums
-
-            list_size = read_short(byte_stream)
-            adc_list_l = read_array(byte_stream, 'u2', list_size)
-
-            without_lg = (adc_list_l & 0x2000) != 0
-            reduced_width = (adc_list_l & 0x4000) != 0
-
-            mlg = mhg16 = mhg8 = 0
-            for wlg, rw in zip(without_lg, reduced_width):
-                if rw:
-                    mhg8 += 1
-                elif n_gains < 2 or wlg:
-                    mhg16 += 1
-                else:
-                    mlg += 1
-                    mhg16 += 1
-
-            adc_list = adc_list_l & 0x1fff   # strip off these marker bits
-
-            data = read_remaining_with_check(byte_stream, self.header.content_size)
-            pos = 0
-
-            if n_gains >= 2:
-                lg, bytes_read = unsigned_varint_arrays_differential(
-                    data[pos:], n_arrays=1, n_elements=mlg
-                )
-                lg = lg[0]
-                pos += bytes_read
-
-            hg, bytes_read = unsigned_varint_arrays_differential(
-                data[pos:], n_arrays=1, n_elements=mhg16
+        if raw['data_red_mode'] == 0 and raw['zero_sup_mode'] in (1, 2):
+            data = view_remaining_with_check(self)
+            raw['adc_sums'], bytes_read = ADCSums._parse_zero_suppressed(
+                data, raw['zero_sup_mode']
             )
-            hg = hg[0]
-            pos += bytes_read
-
-            if mhg8 > 0:
-                hg8 = np.frombuffer(data[pos:pos + mhg8], 'u1', count=mhg8)
-                pos += mhg8
-
-            mlg = mhg16 = mhg8 = 0
-            for i, adc_id in enumerate(adc_list):
-                if reduced_width[i]:
-                    adc_sums[ADCSums.HI_GAIN, adc_id] = hg8[mhg8]
-                    mhg8 += 1
-                else:
-                    adc_sums[ADCSums.HI_GAIN, adc_id] = hg[mhg16]
-                    mhg16 += 1
-                if not without_lg[i] and n_gains > 1:
-                    adc_sums[ADCSums.LO_GAIN, adc_id] = lg[mlg]
-                    mlg += 1
 
             try:
                 return np.squeeze(raw['adc_sums'], axis=-1)
@@ -948,139 +791,127 @@ class ADCSums(EventIOObject):
 
 class ADCSamples(EventIOObject):
     eventio_type = 2013
+    __slots__ = ()
 
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
-        flags_ = header.id
-        self._zero_sup_mode = flags_ & 0x1f
-        self._data_red_mode = (flags_ >> 5) & 0x1f
-        self._list_known = bool((flags_ >> 10) & 0x01)
+    #  !! WTF: raw->zero_sup_mode |= zero_sup_mode << 5
+    @property
+    def _zero_sup_mode(self):
+        return self.header.id & 0x1f
 
-        #  !! WTF: raw->zero_sup_mode |= zero_sup_mode << 5
+    @property
+    def _data_red_mode(self):
+        return (self.header.id >> 5) & 0x1f
 
-        self.telescope_id = (flags_ >> 12) & 0xffff
+    @property
+    def _list_known(self):
+        return bool((self.header.id >> 10) & 0x01)
+
+    @property
+    def telescope_id(self):
+        return (self.header.id >> 12) & 0xffff
 
     def __str__(self):
         return super().__str__() + '(telescope_id={})'.format(self.telescope_id)
 
-    def parse(self):
-        assert_exact_version(self, supported_version=3)
+    @property
+    def instrumentation_variant(self):
+        return 'zero_sup_mode={}'.format(self._zero_sup_mode)
 
-        if (
-            self._data_red_mode == 0 and
-            not self._list_known
-        ):
-            self.seek(0)
-            byte_stream = BytesIO(self.read())
-
-            args = {
-                'byte_stream': byte_stream,
-                'n_pixels': read_int(byte_stream),
-                'n_gains': read_short(byte_stream),
-                'n_samples': read_short(byte_stream),
-            }
-            if self._zero_sup_mode:
-                result = self._parse_in_zero_suppressed_mode(**args)
-            else:
-                result = self._parse_in_not_zero_suppressed_mode(**args)
+    from .parsing import parse_adc_samples as _parse_adc_samples
+    from .parsing import parse_adc_samples_batch as _parse_adc_samples_batch
 
-            try:
-                result = np.squeeze(result, axis=-1)
-            except ValueError:
-                pass
-
-            return result
+    def _check_supported(self):
+        assert_exact_version(self, supported_version=3)
 
-        raise NotImplementedError(
-            (
-                'Currently no support for '
-                'data_red_mode {} and zero_sup_mode {}'
-            ).format(
-                self._data_red_mode, self._zero_sup_mode,
+        if self._data_red_mode != 0 or self._list_known:
+            raise NotImplementedError(
+                (
+                    'Currently no support for '
+                    'data_red_mode {} and zero_sup_mode {}'
+                ).format(
+                    self._data_red_mode, self._zero_sup_mode,
+                )
             )
-        )
 
-    def _parse_in_zero_suppressed_mode(
-        self,
-        byte_stream,
-        n_gains,
-        n_pixels,
-        n_samples,
-    ):
-        adc_samples = np.ones(
-            (n_gains, n_pixels, n_samples),
-            dtype='f4'
-        ) * np.nan
-
-        list_size = read_varint(byte_stream)
-        pixel_ranges = []
-        for _ in range(list_size):
-            start_pixel_id = read_varint(byte_stream)
-            if start_pixel_id < 0:
-                pixel_ranges.append(
-                    (
-                        -start_pixel_id - 1,
-                        -start_pixel_id
-                    )
-                )
-            else:
-                pixel_ranges.append(
-                    (
-                        start_pixel_id,
-                        read_varint(byte_stream) + 1
-                    )
-                )
-        adc_samples = np.zeros(
-            (n_gains, n_pixels, n_samples),
-            dtype='u2'
-        )
-        n_pixels_signal = sum(p[1] - p[0] for p in pixel_ranges)
-        data = read_remaining_with_check(byte_stream, self.header.content_size)
-        adc_samples_signal, bytes_read = unsigned_varint_arrays_differential(
-            data,
-            n_arrays=n_gains * n_pixels_signal,
-            n_elements=n_samples,
+    @staticmethod
+    def _decoder(engine):
+        hessio = load_engine(engine)
+        if hessio is not None:
+            return hessio.parse_adc_samples
+        return ADCSamples._parse_adc_samples
+
+    def parse(self, engine='cython'):
+        '''
+        Parameters
+        ----------
+        engine: str
+            Decoders to use, see `eventio.simtel.engines`
+        '''
+        self._check_supported()
+        self.seek(0)
+        data = view_remaining_with_check(self)
+        result, bytes_read = ADCSamples._decoder(engine)(
+            data, self._zero_sup_mode != 0
         )
-        adc_samples_signal = adc_samples_signal.reshape(
-            n_gains, n_pixels_signal, n_samples
-        ).astype('u2')
-
-        for i_gain in range(n_gains):
-            i_array = 0
-            for pixel_range in pixel_ranges:
-                for i_pix in range(*pixel_range):
-                    adc_samples[i_gain, i_pix, :] = (
-                        adc_samples_signal[i_gain, i_array]
-                    )
-                    i_array += 1
-        return adc_samples
-
-    def _parse_in_not_zero_suppressed_mode(
-        self,
-        byte_stream,
-        n_gains,
-        n_pixels,
-        n_samples,
-    ):
 
-        data = read_remaining_with_check(byte_stream, self.header.content_size)
-        adc_samples, bytes_read = unsigned_varint_arrays_differential(
-            data, n_arrays=n_gains * n_pixels, n_elements=n_samples,
-        )
+        try:
+            result = np.squeeze(result, axis=-1)
+        except ValueError:
+            pass
 
-        return adc_samples.reshape(
-            n_gains, n_pixels, n_samples
-        ).astype('u2')
+        return result
+
+    @property
+    def shape(self):
+        '''(n_gains, n_pixels, n_samples) of the samples, without decoding them'''
+        self.seek(0)
+        n_pixels, n_gains, n_samples = read_from(self, '<ihh')
+        return n_gains, n_pixels, n_samples
+
+    def parse_into(self, output, engine='cython'):
+        '''Decode the samples into `output`, a preallocated, C-contiguous
+        uint16 array of shape (n_gains, n_pixels, n_samples).
+        Unlike `parse`, the sample axis is never squeezed.
+        '''
+        self._check_supported()
+        self.seek(0)
+        data = view_remaining_with_check(self)
+        ADCSamples._decoder(engine)(data, self._zero_sup_mode != 0, output)
+        return output
+
+    @staticmethod
+    def parse_batch(adc_samples, output, engine='cython'):
+        '''Decode a sequence of `ADCSamples` objects, e.g. of all telescopes of
+        one type, into `output` of shape (n_objects, n_gains, n_pixels, n_samples).
+        With the cython engine, all objects are decoded in one compiled call.'''
+        if len(adc_samples) != len(output):
+            raise ValueError('Got {} objects for output with {} entries'.format(
+                len(adc_samples), len(output)
+            ))
+
+        if load_engine(engine) is not None:
+            for o, out in zip(adc_samples, output):
+                o.parse_into(out, engine=engine)
+            return output
+
+        payloads = []
+        for o in adc_samples:
+            o._check_supported()
+            o.seek(0)
+            payloads.append(view_remaining_with_check(o))
+
+        return ADCSamples._parse_adc_samples_batch(
+            payloads, [o._zero_sup_mode != 0 for o in adc_samples], output,
+        )
 
 
 class ImageParameters(EventIOObject):
     eventio_type = 2014
+    __slots__ = ()
 
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
-        self.telescope_id = (
-            (self.header.id & 0xff) | (self.header.id & 0x3f000000) >> 16
-        )
+    @property
+    def telescope_id(self):
+        return (self.header.id & 0xff) | (self.header.id & 0x3f000000) >> 16
 
     def __str__(self):
         return '{}[{}](telescope_id={})'.format(
@@ -1154,6 +985,7 @@ class ImageParameters(EventIOObject):
 
 class StereoReconstruction(EventIOObject):
     eventio_type = 2015
+    __slots__ = ()
 
     def __str__(self):
         return '{}[{}](result_bits={})'.format(
@@ -1218,6 +1050,7 @@ class StereoReconstruction(EventIOObject):
 
 class PixelTiming(TelescopeObject):
     eventio_type = 2016
+    __slots__ = ()
     from ..var_int import simtel_pixel_timing_parse_list_type_1 as _parse_list_type_1
     from ..var_int import simtel_pixel_timing_parse_list_type_2 as _parse_list_type_2
 
@@ -1294,9 +1127,7 @@ class PixelCalibration(EventIOObject):
 
 class MCShower(EventIOObject):
     eventio_type = 2020
-
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
+    __slots__ = ()
 
     def __str__(self):
         return '{}[{}](shower_id={})'.format(
@@ -1366,6 +1197,7 @@ class MCExtraParams(EventIOObject):
 
 class MCEvent(EventIOObject):
     eventio_type = 2021
+    __slots__ = ()
 
     from .parsing import parse_mc_event
 
@@ -1381,7 +1213,7 @@ class MCEvent(EventIOObject):
         assert_version_in(self, (1, 2))
         self.seek(0)
 
-        d = MCEvent.parse_mc_event(self.read(), self.header.version)
+        d = MCEvent.parse_mc_event(self.view(), self.header.version)
         d['event_id'] = self.header.id
         return d
 
@@ -1653,11 +1485,15 @@ class MCPhotoelectronSum(EventIOObject):
 class PixelList(EventIOObject):
     eventio_type = 2027
     kinds = {0: 'triggered', 1: 'selected'}
+    __slots__ = ()
 
-    def __init__(self, header, filehandle):
-        super().__init__(header, filehandle)
-        self.telescope_id = self.header.id % 1000000
-        self.code = self.header.id // 1000000
+    @property
+    def telescope_id(self):
+        return self.header.id % 1000000
+
+    @property
+    def code(self):
+        return self.header.id // 1000000
 
     def __str__(self):
         return '{}[{}](telescope_id={}, code={}, kind={})'.format(
@@ -1719,9 +1555,11 @@ class FSPhot(EventIOObject):
 
 class PixelTriggerTimes(TelescopeObject):
     eventio_type = 2032
+    __slots__ = ()
 
     def parse(self):
         assert_exact_version(self, supported_version=0)
+        self.seek(0)
         byte_stream = BytesIO(self.read())
 
         trigger_times = {}
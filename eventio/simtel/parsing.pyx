@@ -1,51 +1,90 @@
 # cython: language_level=3
 import cython
-from cpython cimport array
-from libc.stdint cimport uint8_t, uint32_t, uint64_t, int16_t, int32_t
+from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t, int16_t, int32_t, int64_t
+from libc.stdlib cimport malloc, free
+from libc.string cimport memcpy, memset
 import numpy as np
 cimport numpy as np
+from eventio.var_int_kernels cimport (
+    STATUS_OK,
+    STATUS_BUFFER_OVERRUN,
+    STATUS_INDEX_OUT_OF_RANGE,
+    buffer_pointer,
+    check_status,
+    decode_unsigned_varint_differential,
+    read_float,
+    read_int16,
+    read_int32,
+    read_varint,
+)
+from eventio.var_int import CSRList
+
+np.import_array()
 
 INT16 = np.int16
 
+@cython.boundscheck(False)
 @cython.wraparound(False)  # disable negative indexing
 cpdef read_sector_information_v1(
-    const uint8_t[:] data,
+    const uint8_t[::1] data,
     uint64_t n_pixels,
     uint64_t offset = 0,
 ):
+    '''Read the int16 sector lists of all pixels of a CameraOrganization (version 1).
+
+    Returns
+    -------
+    sectors: CSRList
+        The sectors of each pixel, stored as ``offsets`` (n_pixels + 1)
+        into the flat int16 array ``values``
+    bytes_read: int
+    '''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
     cdef uint64_t i
-    cdef int32_t j, n
-    cdef int16_t* short_ptr
+    cdef uint64_t n_values = 0
+    cdef int16_t n
+    cdef int status = STATUS_OK
 
-    cdef list sectors = []
-    cdef array.array sector
+    # each value takes two bytes, so the flat array of
+    # all sector entries cannot be longer than half the remaining data
+    cdef uint64_t capacity = (size - offset) // 2 if size > offset else 0
+    cdef np.npy_intp[1] shape = [capacity]
+    cdef np.ndarray[int16_t, ndim=1] values = np.PyArray_SimpleNew(1, shape, np.NPY_INT16)
+    shape[0] = n_pixels + 1
+    cdef np.ndarray[int64_t, ndim=1] offsets = np.PyArray_SimpleNew(1, shape, np.NPY_INT64)
+    cdef int16_t* values_ptr = <int16_t*> np.PyArray_DATA(values)
+    cdef int64_t* offsets_ptr = <int64_t*> np.PyArray_DATA(offsets)
 
     cdef uint64_t pos = offset
-    for i in range(n_pixels):
-
-        short_ptr = <int16_t*> &data[pos]
-        n = short_ptr[0]
-        pos += 2
+    with nogil:
+        offsets_ptr[0] = 0
+        for i in range(n_pixels):
+            status = read_int16(ptr, size, &pos, &n)
+            if status != STATUS_OK:
+                break
+            if n < 0 or pos + 2 * n > size:
+                status = STATUS_BUFFER_OVERRUN
+                break
 
-        sector = array.array('h')
-        for j in range(n):
-            short_ptr = <int16_t*> &data[pos]
-            sector.append(short_ptr[0])
-            pos += 2
+            memcpy(values_ptr + n_values, ptr + pos, 2 * n)
+            pos += 2 * n
+            n_values += n
+            offsets_ptr[i + 1] = n_values
 
-        # FIXME:
-        # according to a comment in the c-sources
-        # there is might be an old bug here,
-        # which is trailing zeros.
-        # is an ascending list of numbes, so any zero
-        # after the first position indicates the end of sector.
-        #
-        # DN: maybe this bug was fixed long ago,
-        # so maybe we do not have to account for it here
-        # I will check for it in the tests.
-        sectors.append(sector)
+    check_status(status)
 
-    return sectors, pos - offset
+    # FIXME:
+    # according to a comment in the c-sources
+    # there is might be an old bug here,
+    # which is trailing zeros.
+    # is an ascending list of numbes, so any zero
+    # after the first position indicates the end of sector.
+    #
+    # DN: maybe this bug was fixed long ago,
+    # so maybe we do not have to account for it here
+    # I will check for it in the tests.
+    return CSRList(offsets, values[:n_values].copy()), pos - offset
 
 
 
@@ -77,3 +116,649 @@ cpdef dict parse_mc_event(
         'ycore': ycore,
         'aweight': aweight
     }
+
+
+cdef int read_pixel_range(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    uint32_t n_pixels,
+    int64_t* start,
+    int64_t* stop,
+) nogil:
+    # a negative value encodes a single pixel -value - 1,
+    # otherwise start and last pixel of the range follow
+    cdef int64_t value
+    cdef int status = read_varint(data, size, pos, &value)
+    if status != STATUS_OK:
+        return status
+
+    if value < 0:
+        start[0] = -value - 1
+        stop[0] = -value
+    else:
+        start[0] = value
+        status = read_varint(data, size, pos, &value)
+        if status != STATUS_OK:
+            return status
+        stop[0] = value + 1
+
+    if start[0] < 0 or stop[0] < start[0] or stop[0] > n_pixels:
+        return STATUS_INDEX_OUT_OF_RANGE
+    return STATUS_OK
+
+
+cdef int decode_adc_samples(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    bint zero_suppressed,
+    uint16_t* output,
+    uint32_t n_gains,
+    uint32_t n_pixels,
+    uint32_t n_samples,
+) nogil:
+    cdef uint64_t i, list_start, list_pos
+    cdef int64_t list_size, start, stop, i_range, i_pixel
+    cdef uint32_t i_gain
+    cdef int status = STATUS_OK
+
+    if not zero_suppressed:
+        for i in range(<uint64_t> n_gains * n_pixels):
+            status = decode_unsigned_varint_differential(
+                data, size, pos, output + i * n_samples, n_samples
+            )
+            if status != STATUS_OK:
+                return status
+        return STATUS_OK
+
+    if output != NULL:
+        memset(output, 0, <uint64_t> n_gains * n_pixels * n_samples * sizeof(uint16_t))
+
+    status = read_varint(data, size, pos, &list_size)
+    if status != STATUS_OK:
+        return status
+    if list_size < 0:
+        return STATUS_INDEX_OUT_OF_RANGE
+
+    # the pixel list is only a few bytes, instead of storing it,
+    # we decode it again for each gain
+    list_start = pos[0]
+    for i_range in range(list_size):
+        status = read_pixel_range(data, size, pos, n_pixels, &start, &stop)
+        if status != STATUS_OK:
+            return status
+
+    for i_gain in range(n_gains):
+        list_pos = list_start
+        for i_range in range(list_size):
+            read_pixel_range(data, size, &list_pos, n_pixels, &start, &stop)
+            for i_pixel in range(start, stop):
+                status = decode_unsigned_varint_differential(
+                    data, size, pos,
+                    output + (<uint64_t> i_gain * n_pixels + i_pixel) * n_samples,
+                    n_samples,
+                )
+                if status != STATUS_OK:
+                    return status
+
+    return STATUS_OK
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def parse_adc_samples(const uint8_t[::1] data, bint zero_suppressed, output=None):
+    '''Decode the payload of an ADCSamples object (version 3, data_red_mode 0,
+    no known list) into a uint16 array of shape (n_gains, n_pixels, n_samples).
+
+    Parameters
+    ----------
+    data: bytes-like
+        The payload of the ADCSamples object
+    zero_suppressed: bool
+        If the data is zero suppressed, pixels not in the pixel list are set to 0
+    output: np.ndarray[uint16] or None
+        If given, samples are decoded into this C-contiguous array
+        and no new array is allocated
+
+    Returns
+    -------
+    adc_samples: np.ndarray[uint16]
+    bytes_read: int
+    '''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef uint64_t pos = 0
+    cdef int32_t n_pixels
+    cdef int16_t n_gains, n_samples
+    cdef int status = STATUS_OK
+    cdef uint16_t[:, :, ::1] output_view
+    cdef uint16_t* output_ptr = NULL
+
+    check_status(read_int32(ptr, size, &pos, &n_pixels))
+    check_status(read_int16(ptr, size, &pos, &n_gains))
+    check_status(read_int16(ptr, size, &pos, &n_samples))
+
+    if n_pixels < 0 or n_gains < 0 or n_samples < 0:
+        raise ValueError('Invalid ADCSamples shape ({}, {}, {})'.format(
+            n_gains, n_pixels, n_samples
+        ))
+
+    shape = (n_gains, n_pixels, n_samples)
+    if output is None:
+        output = np.empty(shape, dtype=np.uint16)
+    elif output.shape != shape:
+        raise ValueError('Output has shape {}, but data has shape {}'.format(
+            output.shape, shape
+        ))
+
+    output_view = output
+    if output.size > 0:
+        output_ptr = &output_view[0, 0, 0]
+
+    with nogil:
+        status = decode_adc_samples(
+            ptr, size, &pos, zero_suppressed, output_ptr,
+            n_gains, n_pixels, n_samples,
+        )
+
+    check_status(status)
+    return output, pos
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def parse_adc_samples_batch(payloads, zero_suppressed, output):
+    '''Decode the payloads of several ADCSamples objects of the same shape,
+    e.g. of all telescopes of one type, into one preallocated array.
+    All payloads are decoded in a single call without the GIL,
+    see `parse_adc_samples` for the supported data.
+
+    Parameters
+    ----------
+    payloads: sequence of bytes-like
+        The payloads of the ADCSamples objects
+    zero_suppressed: sequence of bool
+        For each payload, if its data is zero suppressed
+    output: np.ndarray[uint16]
+        C-contiguous array of shape (n_objects, n_gains, n_pixels, n_samples)
+
+    Returns
+    -------
+    output: np.ndarray[uint16]
+    '''
+    cdef uint64_t n_objects = len(payloads)
+    if len(zero_suppressed) != n_objects or output.shape[0] != n_objects:
+        raise ValueError(
+            'Got {} payloads and {} zero suppression flags for output with {} entries'.format(
+                n_objects, len(zero_suppressed), output.shape[0]
+            )
+        )
+    if n_objects == 0:
+        return output
+
+    cdef uint16_t[:, :, :, ::1] output_view = output
+    cdef uint32_t n_gains = output_view.shape[1]
+    cdef uint32_t n_pixels = output_view.shape[2]
+    cdef uint32_t n_samples = output_view.shape[3]
+    cdef uint64_t stride = <uint64_t> n_gains * n_pixels * n_samples
+    cdef uint16_t* output_ptr = NULL
+    if stride > 0:
+        output_ptr = &output_view[0, 0, 0, 0]
+
+    cdef const uint8_t[::1] data
+    cdef uint64_t i, pos
+    cdef int32_t data_n_pixels = 0
+    cdef int16_t data_n_gains = 0, data_n_samples = 0
+    cdef int status = STATUS_OK
+    cdef bint shape_matches = True
+
+    # the memoryviews keep the payloads alive while decoding without the GIL
+    views = []
+    cdef const uint8_t** pointers = <const uint8_t**> malloc(n_objects * sizeof(uint8_t*))
+    cdef uint64_t* sizes = <uint64_t*> malloc(n_objects * sizeof(uint64_t))
+    cdef bint* zero_sup = <bint*> malloc(n_objects * sizeof(bint))
+
+    try:
+        if pointers == NULL or sizes == NULL or zero_sup == NULL:
+            raise MemoryError()
+
+        for i in range(n_objects):
+            data = payloads[i]
+            views.append(data)
+            pointers[i] = buffer_pointer(data)
+            sizes[i] = data.shape[0]
+            zero_sup[i] = zero_suppressed[i]
+
+        with nogil:
+            for i in range(n_objects):
+                pos = 0
+                status = read_int32(pointers[i], sizes[i], &pos, &data_n_pixels)
+                if status == STATUS_OK:
+                    status = read_int16(pointers[i], sizes[i], &pos, &data_n_gains)
+                if status == STATUS_OK:
+                    status = read_int16(pointers[i], sizes[i], &pos, &data_n_samples)
+                if status != STATUS_OK:
+                    break
+
+                if (
+                    <int64_t> data_n_pixels != <int64_t> n_pixels
+                    or <int64_t> data_n_gains != <int64_t> n_gains
+                    or <int64_t> data_n_samples != <int64_t> n_samples
+                ):
+                    shape_matches = False
+                    break
+
+                status = decode_adc_samples(
+                    pointers[i], sizes[i], &pos, zero_sup[i],
+                    output_ptr + i * stride if output_ptr != NULL else NULL,
+                    n_gains, n_pixels, n_samples,
+                )
+                if status != STATUS_OK:
+                    break
+    finally:
+        free(pointers)
+        free(sizes)
+        free(zero_sup)
+
+    if not shape_matches:
+        raise ValueError('Payload {} has shape {}, but output has shape {}'.format(
+            i, (data_n_gains, data_n_pixels, data_n_samples), output.shape[1:]
+        ))
+    check_status(status)
+    return output
+
+
+cdef enum:
+    HI_GAIN = 0
+    LO_GAIN = 1
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cdef int decode_adc_sums_zero_sup_mode_1(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    double* output,
+    uint32_t n_gains,
+    uint32_t n_pixels,
+) nogil:
+    # pixels come in groups of 16, each group starts with a bit mask
+    # of the pixels stored in this group
+    cdef uint32_t lgval[16]
+    cdef uint32_t hgval[16]
+    cdef int16_t zbits
+    cdef uint32_t start, n, j, m, mlg, mhg
+    cdef int status
+
+    for start in range(0, n_pixels, 16):
+        n = min(16, n_pixels - start)
+
+        status = read_int16(data, size, pos, &zbits)
+        if status != STATUS_OK:
+            return status
+
+        m = 0
+        for j in range(16):
+            if zbits & (1 << j):
+                m += 1
+
+        if n_gains == 2:
+            status = decode_unsigned_varint_differential(data, size, pos, lgval, m)
+            if status != STATUS_OK:
+                return status
+
+        status = decode_unsigned_varint_differential(data, size, pos, hgval, m)
+        if status != STATUS_OK:
+            return status
+
+        mlg = 0
+        mhg = 0
+        for j in range(n):
+            if zbits & (1 << j):
+                if n_gains == 2:
+                    output[LO_GAIN * n_pixels + start + j] = lgval[mlg]
+                    mlg += 1
+                output[HI_GAIN * n_pixels + start + j] = hgval[mhg]
+                mhg += 1
+
+    return STATUS_OK
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cdef int decode_adc_sums_zero_sup_mode_2(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    double* output,
+    uint32_t n_gains,
+    uint32_t n_pixels,
+    uint32_t* values,
+) nogil:
+    # an explicit list of pixel ids, the upper bits of each id mark
+    # pixels without low gain (0x2000) and pixels where the high gain
+    # is stored as a single byte (0x4000).
+    # values needs space for two times the number of list entries.
+    cdef int16_t list_size
+    cdef uint64_t list_start
+    cdef uint32_t adc_id
+    cdef uint16_t flags
+    cdef uint32_t i, mlg = 0, mhg16 = 0, mhg8 = 0
+    cdef uint32_t ilg = 0, ihg16 = 0, ihg8 = 0
+    cdef uint32_t* lg
+    cdef uint32_t* hg
+    cdef const uint8_t* hg8
+    cdef bint reduced_width, without_lg
+    cdef int status
+
+    status = read_int16(data, size, pos, &list_size)
+    if status != STATUS_OK:
+        return status
+    if list_size < 0:
+        return STATUS_INDEX_OUT_OF_RANGE
+
+    list_start = pos[0]
+    if list_start + 2 * <uint64_t> list_size > size:
+        return STATUS_BUFFER_OVERRUN
+    pos[0] += 2 * <uint64_t> list_size
+
+    for i in range(list_size):
+        memcpy(&flags, data + list_start + 2 * i, 2)
+        if flags & 0x4000:
+            mhg8 += 1
+        elif n_gains < 2 or (flags & 0x2000):
+            mhg16 += 1
+        else:
+            mlg += 1
+            mhg16 += 1
+
+    lg = values
+    hg = values + mlg
+    if n_gains >= 2:
+        status = decode_unsigned_varint_differential(data, size, pos, lg, mlg)
+        if status != STATUS_OK:
+            return status
+
+    status = decode_unsigned_varint_differential(data, size, pos, hg, mhg16)
+    if status != STATUS_OK:
+        return status
+
+    if pos[0] + mhg8 > size:
+        return STATUS_BUFFER_OVERRUN
+    hg8 = data + pos[0]
+    pos[0] += mhg8
+
+    for i in range(list_size):
+        memcpy(&flags, data + list_start + 2 * i, 2)
+        adc_id = flags & 0x1fff
+        reduced_width = (flags & 0x4000) != 0
+        without_lg = (flags & 0x2000) != 0
+
+        if adc_id >= n_pixels:
+            return STATUS_INDEX_OUT_OF_RANGE
+
+        if reduced_width:
+            output[HI_GAIN * n_pixels + adc_id] = hg8[ihg8]
+            ihg8 += 1
+        else:
+            output[HI_GAIN * n_pixels + adc_id] = hg[ihg16]
+            ihg16 += 1
+
+        if not without_lg and n_gains > 1:
+            if ilg >= mlg:
+                return STATUS_INDEX_OUT_OF_RANGE
+            output[LO_GAIN * n_pixels + adc_id] = lg[ilg]
+            ilg += 1
+
+    return STATUS_OK
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def parse_adc_sums_zero_suppressed(const uint8_t[::1] data, int zero_sup_mode):
+    '''Decode the payload of a zero suppressed ADCSums object
+    (version 3, data_red_mode 0, zero_sup_mode 1 or 2).
+
+    Pixels not stored in the data are set to 0.
+
+    Returns
+    -------
+    adc_sums: np.ndarray[float64]
+        array of shape (n_gains, n_pixels)
+    bytes_read: int
+    '''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef uint64_t pos = 0
+    cdef int32_t n_pixels
+    cdef int16_t n_gains
+    cdef double[:, ::1] output_view
+    cdef double* output_ptr = NULL
+    cdef uint32_t* values = NULL
+    cdef uint64_t list_pos
+    cdef int16_t list_size
+    cdef int status = STATUS_OK
+
+    if zero_sup_mode not in (1, 2):
+        raise ValueError('Unsupported zero_sup_mode {}'.format(zero_sup_mode))
+
+    check_status(read_int32(ptr, size, &pos, &n_pixels))
+    check_status(read_int16(ptr, size, &pos, &n_gains))
+
+    if n_pixels < 0 or n_gains < 0 or (n_gains == 0 and n_pixels > 0):
+        raise ValueError('Invalid ADCSums shape ({}, {})'.format(n_gains, n_pixels))
+
+    output = np.zeros((n_gains, n_pixels), dtype=np.float64)
+    output_view = output
+    if output.size > 0:
+        output_ptr = &output_view[0, 0]
+
+    if zero_sup_mode == 1:
+        with nogil:
+            status = decode_adc_sums_zero_sup_mode_1(
+                ptr, size, &pos, output_ptr, n_gains, n_pixels
+            )
+    else:
+        # at most one low and one high gain value per list entry
+        list_pos = pos
+        check_status(read_int16(ptr, size, &list_pos, &list_size))
+        values = <uint32_t*> malloc((2 * max(list_size, 0) + 1) * sizeof(uint32_t))
+        if values == NULL:
+            raise MemoryError()
+        try:
+            with nogil:
+                status = decode_adc_sums_zero_sup_mode_2(
+                    ptr, size, &pos, output_ptr, n_gains, n_pixels, values
+                )
+        finally:
+            free(values)
+
+    check_status(status)
+    return output, pos
+
+
+cdef np.ndarray read_fixed_array(
+    const uint8_t* ptr, uint64_t size, uint64_t* pos, int64_t count, int typenum, uint64_t itemsize
+):
+    '''Copy ``count`` little endian values of a fixed size type into a new array'''
+    cdef np.npy_intp[1] shape = [count]
+    cdef np.ndarray result
+
+    if count < 0:
+        raise ValueError('Invalid array length {}'.format(count))
+    if pos[0] + count * itemsize > size:
+        check_status(STATUS_BUFFER_OVERRUN)
+
+    result = np.PyArray_SimpleNew(1, shape, typenum)
+    if count > 0:
+        memcpy(np.PyArray_DATA(result), ptr + pos[0], count * itemsize)
+    pos[0] += count * itemsize
+    return result
+
+
+cdef np.ndarray read_varint_array(
+    const uint8_t* ptr, uint64_t size, uint64_t* pos, int64_t count
+):
+    cdef np.npy_intp[1] shape = [count]
+    cdef np.ndarray result
+    cdef int64_t* values
+    cdef int64_t i
+    cdef int status = STATUS_OK
+
+    if count < 0:
+        raise ValueError('Invalid array length {}'.format(count))
+    # each varint takes at least one byte
+    if pos[0] + count > size:
+        check_status(STATUS_BUFFER_OVERRUN)
+
+    result = np.PyArray_SimpleNew(1, shape, np.NPY_INT64)
+    values = <int64_t*> np.PyArray_DATA(result)
+    with nogil:
+        for i in range(count):
+            status = read_varint(ptr, size, pos, &values[i])
+            if status != STATUS_OK:
+                break
+    check_status(status)
+    return result
+
+
+cdef tuple read_time(const uint8_t* ptr, uint64_t size, uint64_t* pos):
+    cdef int32_t seconds, nanoseconds
+    check_status(read_int32(ptr, size, pos, &seconds))
+    check_status(read_int32(ptr, size, pos, &nanoseconds))
+    return seconds, nanoseconds
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cpdef dict parse_trigger_information(const uint8_t[::1] data, uint32_t version):
+    '''Decode the payload of a TriggerInformation object (versions 0 to 3)'''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef uint64_t pos = 0
+    cdef int32_t value
+    cdef int16_t n_triggered = 0
+    cdef int16_t n_data
+    cdef int16_t i
+    cdef int trigger
+    cdef uint8_t mask
+    cdef float t, az, alt, speed_of_light
+    cdef const int16_t[::1] triggered_view
+    cdef const uint8_t[::1] mask_view
+    cdef np.ndarray triggered = None
+    cdef np.ndarray masks
+    cdef dict info = {}
+    cdef dict time_by_type, times
+
+    info['cpu_time'] = read_time(ptr, size, &pos)
+    info['gps_time'] = read_time(ptr, size, &pos)
+    check_status(read_int32(ptr, size, &pos, &value))
+    info['trigger_pattern'] = value
+    check_status(read_int32(ptr, size, &pos, &value))
+    info['data_pattern'] = value
+
+    if version >= 1:
+        check_status(read_int16(ptr, size, &pos, &n_triggered))
+        info['n_triggered_telescopes'] = n_triggered
+        triggered = read_fixed_array(ptr, size, &pos, n_triggered, np.NPY_INT16, 2)
+        info['triggered_telescopes'] = triggered
+        info['trigger_times'] = read_fixed_array(ptr, size, &pos, n_triggered, np.NPY_FLOAT32, 4)
+
+        check_status(read_int16(ptr, size, &pos, &n_data))
+        info['n_telescopes_with_data'] = n_data
+        info['telescopes_with_data'] = read_fixed_array(ptr, size, &pos, n_data, np.NPY_INT16, 2)
+
+    if version >= 2:
+        # the trigger mask is stored as count type, but only uses 4 bits
+        # so it is identical to a single unsigned byte
+        masks = read_fixed_array(ptr, size, &pos, n_triggered, np.NPY_UINT8, 1)
+        info['teltrg_type_mask'] = masks
+        triggered_view = triggered
+        mask_view = masks
+
+        time_by_type = {}
+        for i in range(n_triggered):
+            mask = mask_view[i]
+            if mask >= 128:
+                raise ValueError('Unexpected trigger mask {}'.format(mask))
+
+            # trigger times are only written if more than one trigger is there
+            if mask == 0b001 or mask == 0b010 or mask == 0b100:
+                continue
+
+            times = {}
+            for trigger in range(3):
+                if mask & (1 << trigger):
+                    check_status(read_float(ptr, size, &pos, &t))
+                    times[trigger] = t
+            time_by_type[triggered_view[i]] = times
+        info['teltrg_time_by_type'] = time_by_type
+
+    if version >= 3:
+        # information about "plane wavefront compensation"
+        check_status(read_float(ptr, size, &pos, &az))
+        check_status(read_float(ptr, size, &pos, &alt))
+        check_status(read_float(ptr, size, &pos, &speed_of_light))
+        info['plane_wavefront_compensation'] = {
+            'az': az, 'alt': alt, 'speed_of_light': speed_of_light,
+        }
+
+    return info
+
+
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cpdef dict parse_telescope_event_header(
+    const uint8_t[::1] data, uint32_t version, int64_t telescope_id
+):
+    '''Decode the payload of a TelescopeEventHeader object (versions 0 to 3)'''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef uint64_t pos = 0
+    cdef int32_t value
+    cdef int16_t t, n16
+    cdef int64_t n
+    cdef float readout_time, relative_trigger_time
+    cdef dict head = {}
+
+    check_status(read_int32(ptr, size, &pos, &value))
+    head['loc_count'] = value
+    check_status(read_int32(ptr, size, &pos, &value))
+    head['glob_count'] = value
+    head['cpu_time'] = read_time(ptr, size, &pos)
+    head['gps_time'] = read_time(ptr, size, &pos)
+    check_status(read_int16(ptr, size, &pos, &t))
+    head['trg_source'] = t & 0xff
+
+    if t & 0x100:
+        if version <= 1:
+            check_status(read_int16(ptr, size, &pos, &n16))
+            n = n16
+            head['list_trgsect'] = read_fixed_array(ptr, size, &pos, n, np.NPY_INT16, 2)
+        else:
+            check_status(read_varint(ptr, size, &pos, &n))
+            head['list_trgsect'] = read_varint_array(ptr, size, &pos, n)
+
+        if version >= 1 and (t & 0x400):
+            head['time_trgsect'] = read_fixed_array(ptr, size, &pos, n, np.NPY_FLOAT32, 4)
+
+    if t & 0x200:
+        if version <= 1:
+            check_status(read_int16(ptr, size, &pos, &n16))
+            n = n16
+            head['phys_addr'] = read_fixed_array(ptr, size, &pos, n, np.NPY_INT16, 2)
+        else:
+            check_status(read_varint(ptr, size, &pos, &n))
+            head['phys_addr'] = read_varint_array(ptr, size, &pos, n)
+        head['n_phys_addr'] = n
+
+    if version >= 3:
+        check_status(read_float(ptr, size, &pos, &readout_time))
+        check_status(read_float(ptr, size, &pos, &relative_trigger_time))
+        head['readout_time'] = readout_time
+        head['relative_trigger_time'] = relative_trigger_time
+
+    head['telescope_id'] = telescope_id
+    return head
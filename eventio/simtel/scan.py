@@ -0,0 +1,319 @@
+'''
+Fast scan of the monte carlo and trigger information of a simtel file.
+
+Only the `MCShower`, `MCEvent` and the `TriggerInformation` of each
+toplevel `ArrayEvent` are read, all other objects are skipped using
+the object index of the file (see `eventio.index.EventIOIndex`).
+No eventio objects are created, the fixed size parts of the payloads
+are decoded for all objects of a type at once into preallocated
+structured arrays.
+'''
+import numpy as np
+
+from ..base import EventIOFile, MemoryMappedFile
+from ..index import EventIOIndex
+from .index import _match_preceding
+from .objects import ArrayEvent, MCEvent, MCShower, TriggerInformation
+
+
+__all__ = [
+    'SHOWER_DTYPE',
+    'MC_EVENT_DTYPE',
+    'TRIGGER_DTYPE',
+    'scan_event_metadata',
+]
+
+
+SHOWER_DTYPE = np.dtype([
+    ('shower_id', 'u4'),
+    ('primary_id', 'i4'),
+    ('energy', 'f4'),
+    ('azimuth', 'f4'),
+    ('altitude', 'f4'),
+    # nan for version 0
+    ('depth_start', 'f4'),
+    ('h_first_int', 'f4'),
+    ('xmax', 'f4'),
+    ('hmax', 'f4'),
+    ('emax', 'f4'),
+    ('cmax', 'f4'),
+])
+
+MC_EVENT_DTYPE = np.dtype([
+    ('event_id', 'u4'),
+    ('shower_id', 'u4'),
+    ('shower_num', 'i4'),
+    ('xcore', 'f4'),
+    ('ycore', 'f4'),
+    ('aweight', 'f4'),
+    # if there is an ArrayEvent for this mc event
+    ('triggered', '?'),
+])
+
+TRIGGER_DTYPE = np.dtype([
+    ('event_id', 'u4'),
+    ('cpu_time_s', 'i4'),
+    ('cpu_time_ns', 'i4'),
+    ('gps_time_s', 'i4'),
+    ('gps_time_ns', 'i4'),
+    ('trigger_pattern', 'i4'),
+    ('data_pattern', 'i4'),
+    # -1 for version 0
+    ('n_triggered_telescopes', 'i2'),
+    ('n_telescopes_with_data', 'i2'),
+])
+
+
+# binary layout of the fixed size start of the payloads by version
+_SHOWER_LAYOUTS = {
+    0: np.dtype([
+        ('primary_id', '<i4'), ('energy', '<f4'), ('azimuth', '<f4'),
+        ('altitude', '<f4'), ('h_first_int', '<f4'), ('xmax', '<f4'),
+    ]),
+    1: np.dtype([
+        ('primary_id', '<i4'), ('energy', '<f4'), ('azimuth', '<f4'),
+        ('altitude', '<f4'), ('depth_start', '<f4'), ('h_first_int', '<f4'),
+        ('xmax', '<f4'), ('hmax', '<f4'), ('emax', '<f4'), ('cmax', '<f4'),
+    ]),
+}
+_SHOWER_LAYOUTS[2] = _SHOWER_LAYOUTS[1]
+
+_MC_EVENT_LAYOUTS = {
+    1: np.dtype([('shower_num', '<i4'), ('xcore', '<f4'), ('ycore', '<f4')]),
+    2: np.dtype([
+        ('shower_num', '<i4'), ('xcore', '<f4'), ('ycore', '<f4'), ('aweight', '<f4'),
+    ]),
+}
+
+_TRIGGER_LAYOUTS = {
+    0: np.dtype([
+        ('cpu_time_s', '<i4'), ('cpu_time_ns', '<i4'),
+        ('gps_time_s', '<i4'), ('gps_time_ns', '<i4'),
+        ('trigger_pattern', '<i4'), ('data_pattern', '<i4'),
+    ]),
+    1: np.dtype([
+        ('cpu_time_s', '<i4'), ('cpu_time_ns', '<i4'),
+        ('gps_time_s', '<i4'), ('gps_time_ns', '<i4'),
+        ('trigger_pattern', '<i4'), ('data_pattern', '<i4'),
+        ('n_triggered_telescopes', '<i2'),
+    ]),
+}
+_TRIGGER_LAYOUTS[2] = _TRIGGER_LAYOUTS[3] = _TRIGGER_LAYOUTS[1]
+
+
+def gather_records(buffer, offsets, dtype):
+    '''Read one record of `dtype` at each of the byte `offsets` in `buffer`'''
+    data = np.frombuffer(buffer, dtype=np.uint8)
+    idx = np.asarray(offsets, dtype=np.int64)[:, np.newaxis] + np.arange(dtype.itemsize)
+    if idx.size > 0 and idx[:, -1].max() >= len(data):
+        raise EOFError('File seems to be truncated')
+    return data[idx].view(dtype)[:, 0]
+
+
+def _first_trigger_information(objects):
+    '''The row numbers of the first TriggerInformation in each toplevel ArrayEvent
+    and of the ArrayEvent'''
+    depth = objects['depth']
+    rows = np.arange(len(objects))
+    # row of the toplevel object each row belongs to
+    parent = np.maximum.accumulate(np.where(depth == 0, rows, 0))
+
+    is_trigger = (
+        (depth == 1)
+        & (objects['type'] == TriggerInformation.eventio_type)
+        & (objects['type'][parent] == ArrayEvent.eventio_type)
+    )
+    trigger_rows = rows[is_trigger]
+    array_event_rows, first = np.unique(parent[trigger_rows], return_index=True)
+    return trigger_rows[first], array_event_rows
+
+
+def _concatenate_payloads(payloads, row_numbers):
+    '''Concatenate the payloads collected while scanning the file for the
+    index `row_numbers`, returns the data and the offset of each payload in it'''
+    row_numbers = row_numbers.tolist()
+    sizes = np.array([len(payloads[row]) for row in row_numbers], dtype=np.int64)
+    offsets = np.zeros(len(sizes), dtype=np.int64)
+    np.cumsum(sizes[:-1], out=offsets[1:])
+    return b''.join(payloads[row] for row in row_numbers), offsets
+
+
+def _read_payloads(filehandle, rows):
+    '''Read the payloads of the index `rows` from a (possibly only forward)
+    seekable `filehandle`, returns the concatenated payloads
+    and the offset of each payload in them'''
+    starts = rows['offset'].astype(np.int64) + rows['header_size']
+    sizes = rows['size'].astype(np.int64)
+    order = np.argsort(starts, kind='stable')
+
+    data = bytearray(int(sizes.sum()))
+    offsets = np.zeros(len(rows), dtype=np.int64)
+    view = memoryview(data)
+    pos = 0
+    for i in order.tolist():
+        size = int(sizes[i])
+        filehandle.seek(int(starts[i]))
+        payload = filehandle.read(size)
+        if len(payload) != size:
+            raise EOFError('File seems to be truncated')
+        view[pos:pos + size] = payload
+        offsets[i] = pos
+        pos += size
+
+    return data, offsets
+
+
+def _decode(buffer, offsets, versions, layouts, dtype, name):
+    '''Decode the fixed size layouts of all payloads, grouped by version'''
+    result = np.zeros(len(offsets), dtype=dtype)
+    for version in np.unique(versions).tolist():
+        if version not in layouts:
+            raise NotImplementedError(
+                'Unsupported version of {}: {}'.format(name, version)
+            )
+        layout = layouts[version]
+        mask = versions == version
+        records = gather_records(buffer, offsets[mask], layout)
+        for field in layout.names:
+            result[field][mask] = records[field]
+    return result
+
+
+def scan_event_metadata(path, index_cache=True, zcat=True):
+    '''
+    Read the monte carlo showers and events and the trigger information
+    of all array events of the simtel file at `path`, skipping all other data.
+
+    For uncompressed files, the payloads are decoded directly from a
+    memory map of the file. Compressed files are decompressed once:
+    without a valid cached index, the needed payloads are collected while
+    building the index, otherwise they are read using the cached index.
+
+    Parameters
+    ----------
+    path: str
+        Path to the simtel file
+    index_cache: bool
+        If True, the object index is stored next to the file
+        and reused by later scans, see `EventIOIndex.for_file`
+    zcat: bool
+        Passed to `EventIOFile`
+
+    Returns
+    -------
+    tables: dict
+        'showers': np.ndarray[SHOWER_DTYPE], one row per MCShower
+        'mc_events': np.ndarray[MC_EVENT_DTYPE], one row per MCEvent
+        'triggers': np.ndarray[TRIGGER_DTYPE], one row per toplevel ArrayEvent
+    '''
+    # only filled if the index is built by scanning a compressed file
+    payloads = {
+        (MCShower.eventio_type, 0): {},
+        (MCEvent.eventio_type, 0): {},
+        (TriggerInformation.eventio_type, 1): {},
+    }
+    index = EventIOIndex.for_file(path, max_depth=1, cache=index_cache, payloads=payloads)
+    objects = index.objects
+    toplevel = objects['depth'] == 0
+
+    shower_numbers = np.nonzero(toplevel & (objects['type'] == MCShower.eventio_type))[0]
+    mc_event_numbers = np.nonzero(toplevel & (objects['type'] == MCEvent.eventio_type))[0]
+    trigger_numbers, array_event_rows = _first_trigger_information(objects)
+    array_events = objects[array_event_rows]
+    n_array_events = np.count_nonzero(toplevel & (objects['type'] == ArrayEvent.eventio_type))
+    if len(array_events) != n_array_events:
+        raise ValueError('Found ArrayEvent without TriggerInformation')
+
+    numbers = (shower_numbers, mc_event_numbers, trigger_numbers)
+    selected = tuple(objects[n] for n in numbers)
+    shower_rows, mc_event_rows, trigger_rows = selected
+
+    collected = {}
+    for rows in payloads.values():
+        collected.update(rows)
+
+    if collected:
+        buffer, all_offsets = _concatenate_payloads(collected, np.concatenate(numbers))
+        offsets = np.split(all_offsets, np.cumsum([len(n) for n in numbers])[:-1])
+        tables = _decode_tables(buffer, offsets, selected)
+    else:
+        tables = _read_tables(path, selected, zcat=zcat)
+
+    showers, mc_events, triggers = tables
+    showers['shower_id'] = shower_rows['id']
+
+    triggers['event_id'] = array_events['id']
+
+    mc_events['event_id'] = mc_event_rows['id']
+    shower_offsets, idx = _match_preceding(
+        mc_event_rows['offset'].astype(np.int64), None, shower_rows['offset'].astype(np.int64)
+    )
+    has_shower = shower_offsets >= 0
+    mc_events['shower_id'][has_shower] = shower_rows['id'][idx[has_shower]]
+
+    # an mc event triggered, if it is the last mc event
+    # in front of an ArrayEvent with the same id
+    last_mc_event = np.searchsorted(
+        mc_event_rows['offset'], array_events['offset'], side='left'
+    ) - 1
+    valid = last_mc_event >= 0
+    valid[valid] = mc_event_rows['id'][last_mc_event[valid]] == array_events['id'][valid]
+    mc_events['triggered'][last_mc_event[valid]] = True
+
+    return {'showers': showers, 'mc_events': mc_events, 'triggers': triggers}
+
+
+def _read_tables(path, selected, zcat=True):
+    '''Read the payloads of the `selected` index rows from the file and decode them'''
+    with EventIOFile(path, zcat=zcat) as f:
+        if isinstance(f._filehandle, MemoryMappedFile):
+            buffer = f._filehandle.buffer
+            offsets = [
+                rows['offset'].astype(np.int64) + rows['header_size']
+                for rows in selected
+            ]
+            tables = _decode_tables(buffer, offsets, selected)
+            del buffer
+        else:
+            rows = np.concatenate(selected)
+            buffer, all_offsets = _read_payloads(f._filehandle, rows)
+            offsets = np.split(all_offsets, np.cumsum([len(r) for r in selected])[:-1])
+            tables = _decode_tables(buffer, offsets, selected)
+    return tables
+
+
+def _decode_tables(buffer, offsets, selected):
+    shower_rows, mc_event_rows, trigger_rows = selected
+    shower_offsets, mc_event_offsets, trigger_offsets = offsets
+
+    showers = _decode(
+        buffer, shower_offsets, shower_rows['version'],
+        _SHOWER_LAYOUTS, SHOWER_DTYPE, 'MCShower',
+    )
+    showers['depth_start'][shower_rows['version'] == 0] = np.nan
+
+    mc_events = _decode(
+        buffer, mc_event_offsets, mc_event_rows['version'],
+        _MC_EVENT_LAYOUTS, MC_EVENT_DTYPE, 'MCEvent',
+    )
+    mc_events['aweight'][mc_event_rows['version'] < 2] = 1.0
+
+    triggers = _decode(
+        buffer, trigger_offsets, trigger_rows['version'],
+        _TRIGGER_LAYOUTS, TRIGGER_DTYPE, 'TriggerInformation',
+    )
+    has_counts = trigger_rows['version'] >= 1
+    triggers['n_triggered_telescopes'][~has_counts] = -1
+    triggers['n_telescopes_with_data'][~has_counts] = -1
+
+    # the number of telescopes with data follows the int16 ids and float32 times
+    # of the triggered telescopes
+    n_data_offsets = (
+        trigger_offsets[has_counts] + _TRIGGER_LAYOUTS[1].itemsize
+        + 6 * triggers['n_triggered_telescopes'][has_counts].astype(np.int64)
+    )
+    triggers['n_telescopes_with_data'][has_counts] = gather_records(
+        buffer, n_data_offsets, np.dtype('<i2')
+    )
+
+    return showers, mc_events, triggers
@@ -3,13 +3,17 @@ Implementation of an EventIOFile that
 loops through SimTel Array events.
 '''
 import re
-from copy import copy
-from collections import defaultdict
+from collections import defaultdict, deque
+from collections.abc import Mapping
+from concurrent.futures import ProcessPoolExecutor
 import logging
-from ..base import EventIOFile
+from ..base import EventIOFile, OffsetBytesIO, KNOWN_OBJECTS
 from ..exceptions import check_type
+from ..index import EventIOIndex
+from .index import SimTelEventIndex
 from .. import iact
 from ..histograms import Histograms
+from .engines import load_engine
 from .objects import (
     ADCSamples,
     ADCSums,
@@ -51,10 +55,68 @@ telescope_descriptions_types = (
     PointingCorrection,
 )
 
+# telescope descriptions, that are usually identical for all runs
+# of a production and are reused from `description_cache`
+cached_description_types = (
+    CameraSettings,
+    CameraOrganization,
+    PixelSettings,
+)
+
 
 log = logging.getLogger(__name__)
 
 
+class MonitoringSnapshot(Mapping):
+    '''
+    Read-only camera monitoring or laser calibration data of one telescope.
+
+    A new snapshot with an incremented `version` is created
+    for each new monitoring object, so events can reference
+    the snapshot valid for them instead of copying the data.
+    '''
+    __slots__ = ('_data', 'version')
+
+    def __init__(self, data=None, version=0):
+        self._data = dict(data) if data is not None else {}
+        self.version = version
+
+    def updated(self, data):
+        '''A new snapshot with the values of this one updated by `data`'''
+        return MonitoringSnapshot({**self._data, **data}, self.version + 1)
+
+    def __getitem__(self, key):
+        return self._data[key]
+
+    def __iter__(self):
+        return iter(self._data)
+
+    def __len__(self):
+        return len(self._data)
+
+    def __repr__(self):
+        return '{}(version={}, keys={})'.format(
+            self.__class__.__name__, self.version, list(self._data)
+        )
+
+
+# monitoring data of telescopes without any CameraMonitoring / LaserCalibration yet
+EMPTY_MONITORING = MonitoringSnapshot()
+
+
+class MonitoringSnapshots(dict):
+    '''
+    Mapping of telescope id to its latest `MonitoringSnapshot`.
+
+    Telescopes without monitoring data yet give `EMPTY_MONITORING`,
+    without being added to the mapping.
+    '''
+    __slots__ = ()
+
+    def __missing__(self, telescope_id):
+        return EMPTY_MONITORING
+
+
 camel_re1 = re.compile('(.)([A-Z][a-z]+)')
 camel_re2 = re.compile('([a-z0-9])([A-Z])')
 
@@ -69,8 +131,33 @@ class NoTrackingPositions(Exception):
 
 
 class SimTelFile(EventIOFile):
-    def __init__(self, path, allowed_telescopes=None, skip_calibration=False, zcat=True):
-        super().__init__(path, zcat=zcat)
+    def __init__(
+        self,
+        path,
+        allowed_telescopes=None,
+        skip_calibration=False,
+        zcat=True,
+        mmap=True,
+        index_cache=True,
+        seekable=False,
+        n_workers=1,
+        lazy_telescope_events=False,
+        read_ahead=0,
+        instrumentation=False,
+        description_cache=None,
+        engine='cython',
+    ):
+        if lazy_telescope_events and n_workers > 1:
+            raise ValueError(
+                'lazy_telescope_events can not be combined with n_workers > 1'
+            )
+        # fail early if the engine is not available
+        load_engine(engine)
+
+        super().__init__(
+            path, zcat=zcat, mmap=mmap, seekable=seekable, read_ahead=read_ahead,
+            instrumentation=instrumentation,
+        )
 
         self.path = path
         self.allowed_telescopes = None
@@ -86,8 +173,13 @@ class SimTelFile(EventIOFile):
         self.header = None
         self.n_telescopes = None
         self.telescope_descriptions = defaultdict(dict)
-        self.camera_monitorings = defaultdict(dict)
-        self.laser_calibrations = defaultdict(dict)
+        # dict shared between files, mapping the raw payload of
+        # the `cached_description_types` to their parsed content
+        self.description_cache = description_cache
+        # latest `MonitoringSnapshot` per telescope, replaced (not modified)
+        # when new data is read, so events can reference them without copying
+        self.camera_monitorings = MonitoringSnapshots()
+        self.laser_calibrations = MonitoringSnapshots()
         self.current_mc_shower = None
         self.current_mc_shower_id = None
         self.current_mc_event = None
@@ -101,6 +193,21 @@ class SimTelFile(EventIOFile):
         self.current_calibration_event = None
         self.skip_calibration = skip_calibration
 
+        # if True, telescope events are `LazyTelescopeEvent`s
+        self.lazy_telescope_events = lazy_telescope_events
+        # decoders for the adc data, see `eventio.simtel.engines`
+        self.engine = engine
+
+        # with n_workers > 1, array events are parsed in a process pool
+        self.n_workers = n_workers
+        self._executor = None
+        self._pending_events = deque()
+
+        # random access to events, see `seek_event`
+        self.index_cache = index_cache
+        self._event_index = None
+        self._parsed_monitoring = {}
+
         # read the header:
         # assumption: the header is done when
         # any of the objects in check is not None anymore
@@ -129,8 +236,92 @@ class SimTelFile(EventIOFile):
     def __iter__(self):
         return self.iter_array_events()
 
-    def next_low_level(self):
-        o = next(self)
+    @property
+    def event_index(self):
+        '''Index of the array events in this file.
+
+        Built on first access by scanning the object headers of the file.
+        If `index_cache` is True, the index is stored next to the file
+        as `<path>.eventio-idx` and reused as long as the file does not change.
+        '''
+        if self._event_index is None:
+            index = EventIOIndex.for_file(
+                self.path, max_depth=1, cache=self.index_cache
+            )
+            self._event_index = SimTelEventIndex(index)
+        return self._event_index
+
+    def seek_event(self, event_id):
+        '''Move to the event with the given `event_id`, so that it
+        is the next event returned by `iter_array_events`.
+
+        The mc shower and the latest camera monitoring and laser calibration
+        data in front of the event are parsed, all intermediate events are skipped.
+        For compressed files, this requires that the file supports
+        seeking backwards to go back to previous events.
+        '''
+        event_index = self.event_index
+        event = event_index[event_id]
+        start = event_index.event_start(event_id)
+
+        # monitoring data read after the start of the event, e.g. before
+        # seeking backwards, is not valid for it
+        for key, (offset, snapshots, telescope_id) in list(self._parsed_monitoring.items()):
+            if offset >= start:
+                del self._parsed_monitoring[key]
+                snapshots.pop(telescope_id, None)
+
+        to_parse = []
+        for key, offset in event_index.monitoring_offsets(start).items():
+            parsed = self._parsed_monitoring.get(key)
+            if parsed is None or parsed[0] != offset:
+                to_parse.append(offset)
+
+        shower_offset = int(event['mc_shower'])
+        if shower_offset >= 0 and self.current_mc_shower_id != int(event['shower_id']):
+            to_parse.append(shower_offset)
+
+        self.next = None
+        for offset in sorted(to_parse):
+            self._next_header_pos = offset
+            self.next_low_level()
+
+        self.current_mc_event = None
+        self.current_mc_event_id = None
+        self.current_telescope_data_event_id = None
+        self.current_photoelectron_sum = None
+        self.current_photoelectrons = {}
+        self.current_photons = {}
+        self.current_emitter = {}
+        self.current_array_event = None
+        self.current_calibration_event = None
+
+        self._next_header_pos = start
+
+    def __getitem__(self, event_id):
+        '''Random access to the array event with the given `event_id`.
+
+        Raises a KeyError if the event is not in the file or it
+        contains none of the `allowed_telescopes`.
+        '''
+        self.seek_event(event_id)
+        array_event_offset = int(self.event_index[event_id]['array_event'])
+
+        while self._next_header_pos <= array_event_offset:
+            self.next_low_level()
+
+        event = self.try_build_event()
+        if event is None:
+            raise KeyError(
+                'Event {} has no data for the allowed telescopes'.format(event_id)
+            )
+        return event
+
+    def next_low_level(self, o=None):
+        '''Read the next toplevel object and update the state of this file.
+        `o` can be given if the object was already read, e.g. by `AsyncSimTelFile`'''
+        if o is None:
+            o = next(self)
 
         # order of if statements is roughly sorted
         # by the number of occurences in a simtel file
@@ -145,27 +336,38 @@ class SimTelFile(EventIOFile):
             self.current_mc_shower_id = o.header.id
 
         elif isinstance(o, ArrayEvent):
-            self.current_array_event = parse_array_event(
-                o,
-                self.allowed_telescopes
-            )
+            if self._executor is not None:
+                self._submit_array_event(o)
+            else:
+                self.current_array_event = parse_array_event(
+                    o,
+                    self.allowed_telescopes,
+                    lazy=self.lazy_telescope_events,
+                    engine=self.engine,
+                )
 
         elif isinstance(o, iact.TelescopeData):
-            event_id, photons, emitter, photoelectrons = parse_telescope_data(o)
+            event_id, photons, emitter, photoelectrons = parse_telescope_data(
+                o, self.allowed_telescopes
+            )
             self.current_telescope_data_event_id = event_id
             self.current_photons = photons
             self.current_emitter = emitter
             self.current_photoelectrons = photoelectrons
 
         elif isinstance(o, CameraMonitoring):
-            self.camera_monitorings[o.telescope_id].update(o.parse())
+            if self._is_allowed(o.telescope_id):
+                update_monitoring(self.camera_monitorings, o.telescope_id, o.parse())
+            self._remember_monitoring(o, self.camera_monitorings)
 
         elif isinstance(o, LaserCalibration):
-            self.laser_calibrations[o.telescope_id].update(o.parse())
+            if self._is_allowed(o.telescope_id):
+                update_monitoring(self.laser_calibrations, o.telescope_id, o.parse())
+            self._remember_monitoring(o, self.laser_calibrations)
 
         elif isinstance(o, telescope_descriptions_types):
             key = camel_to_snake(o.__class__.__name__)
-            self.telescope_descriptions[o.telescope_id][key] = o.parse()
+            self.telescope_descriptions[o.telescope_id][key] = self._parse_description(o)
 
         elif isinstance(o, RunHeader):
             self.header = o.parse()
@@ -184,6 +386,8 @@ class SimTelFile(EventIOFile):
                 self.current_calibration_event = parse_array_event(
                     next(o),
                     self.allowed_telescopes,
+                    lazy=self.lazy_telescope_events,
+                    engine=self.engine,
                 )
                 self.current_calibration_event['calibration_type'] = o.type
 
@@ -201,6 +405,31 @@ class SimTelFile(EventIOFile):
                 'at the moment: {}'.format(o)
             )
 
+    def _parse_description(self, o):
+        cache = self.description_cache
+        if cache is None or not isinstance(o, cached_description_types):
+            return o.parse()
+
+        header = o.header
+        o.seek(0)
+        payload = o.read()
+        key = (header.type, header.version, header.id, payload)
+        description = cache.get(key)
+        if description is None:
+            f = OffsetBytesIO(payload, header.content_address)
+            description = cache[key] = o.__class__(header, f).parse()
+        return description
+
+    def _is_allowed(self, telescope_id):
+        return self.allowed_telescopes is None or telescope_id in self.allowed_telescopes
+
+    def _remember_monitoring(self, o, snapshots):
+        # needed by seek_event to know which monitoring data are current
+        # and which have to be reset when seeking backwards
+        key = (o.header.type, o.header.id)
+        offset = o.header.content_address - o.header.header_size
+        self._parsed_monitoring[key] = (offset, snapshots, o.telescope_id)
+
     def iter_mc_events(self):
         while True:
             try:
@@ -230,6 +459,10 @@ class SimTelFile(EventIOFile):
         self.next_low_level()
 
     def iter_array_events(self):
+        if self.n_workers > 1:
+            yield from self._iter_array_events_parallel()
+            return
+
         while True:
 
             next_event = self.try_build_event()
@@ -246,46 +479,13 @@ class SimTelFile(EventIOFile):
         then make an event and invalidate old data
         '''
         if self.current_array_event:
-            if (
-                self.allowed_telescopes
-                and not self.current_array_event['telescope_events']
-            ):
-                self.current_array_event = None
-                return None
-
-            event_data = {
-                'type': 'data',
-                'event_id': self.current_mc_event_id,
-                'mc_shower': self.current_mc_shower,
-                'mc_event': self.current_mc_event,
-                'telescope_events': self.current_array_event['telescope_events'],
-                'tracking_positions': self.current_array_event['tracking_positions'],
-                'trigger_information': self.current_array_event['trigger_information'],
-                'photons': self.current_photons,
-                'emitter': self.current_emitter,
-                'photoelectrons': self.current_photoelectrons,
-                'photoelectron_sums': self.current_photoelectron_sum,
-            }
-
-            event_data['camera_monitorings'] = {
-                telescope_id: copy(self.camera_monitorings[telescope_id])
-                for telescope_id in self.current_array_event['telescope_events'].keys()
-            }
-            event_data['laser_calibrations'] = {
-                telescope_id: copy(self.laser_calibrations[telescope_id])
-                for telescope_id in self.current_array_event['telescope_events'].keys()
-            }
-
+            array_event = self.current_array_event
             self.current_array_event = None
-
-            return event_data
+            return self._make_data_event(array_event, self._event_context())
 
         elif self.current_calibration_event:
             event = self.current_calibration_event
-            if (
-                self.allowed_telescopes
-                and not self.current_array_event['telescope_events']
-            ):
+            if self.allowed_telescopes and not event['telescope_events']:
                 self.current_calibration_event = None
                 return None
 
@@ -298,11 +498,11 @@ class SimTelFile(EventIOFile):
             }
 
             event_data['camera_monitorings'] = {
-                telescope_id: copy(self.camera_monitorings[telescope_id])
+                telescope_id: self.camera_monitorings.get(telescope_id, EMPTY_MONITORING)
                 for telescope_id in event['telescope_events'].keys()
             }
             event_data['laser_calibrations'] = {
-                telescope_id: copy(self.laser_calibrations[telescope_id])
+                telescope_id: self.laser_calibrations.get(telescope_id, EMPTY_MONITORING)
                 for telescope_id in event['telescope_events'].keys()
             }
 
@@ -310,8 +510,134 @@ class SimTelFile(EventIOFile):
 
             return event_data
 
+    def _event_context(self, snapshot=False):
+        '''The non array event data belonging to the current event.
+
+        With snapshot=True, the mappings of telescope id to monitoring
+        data are copied, so the context stays valid while reading continues.
+        The monitoring data themselves are immutable and never copied.
+        '''
+        camera_monitorings = self.camera_monitorings
+        laser_calibrations = self.laser_calibrations
+        if snapshot:
+            camera_monitorings = MonitoringSnapshots(camera_monitorings)
+            laser_calibrations = MonitoringSnapshots(laser_calibrations)
+
+        return {
+            'event_id': self.current_mc_event_id,
+            'mc_shower': self.current_mc_shower,
+            'mc_event': self.current_mc_event,
+            'photons': self.current_photons,
+            'emitter': self.current_emitter,
+            'photoelectrons': self.current_photoelectrons,
+            'photoelectron_sums': self.current_photoelectron_sum,
+            'camera_monitorings': camera_monitorings,
+            'laser_calibrations': laser_calibrations,
+        }
+
+    def _make_data_event(self, array_event, context):
+        if self.allowed_telescopes and not array_event['telescope_events']:
+            return None
+
+        event_data = {
+            'type': 'data',
+            'event_id': context['event_id'],
+            'mc_shower': context['mc_shower'],
+            'mc_event': context['mc_event'],
+            'telescope_events': array_event['telescope_events'],
+            'tracking_positions': array_event['tracking_positions'],
+            'trigger_information': array_event['trigger_information'],
+            'photons': context['photons'],
+            'emitter': context['emitter'],
+            'photoelectrons': context['photoelectrons'],
+            'photoelectron_sums': context['photoelectron_sums'],
+        }
+
+        telescope_ids = array_event['telescope_events'].keys()
+        event_data['camera_monitorings'] = {
+            telescope_id: context['camera_monitorings'].get(telescope_id, EMPTY_MONITORING)
+            for telescope_id in telescope_ids
+        }
+        event_data['laser_calibrations'] = {
+            telescope_id: context['laser_calibrations'].get(telescope_id, EMPTY_MONITORING)
+            for telescope_id in telescope_ids
+        }
+
+        return event_data
+
+    def _submit_array_event(self, o):
+        '''Send the raw ArrayEvent to a worker process for parsing'''
+        o.seek(0)
+        future = self._executor.submit(
+            _parse_array_event_payload,
+            o.header, o.read(), self.allowed_telescopes, self.engine,
+        )
+        self._pending_events.append((future, self._event_context(snapshot=True)))
+
+    def _iter_array_events_parallel(self):
+        # events are parsed in the order they are submitted, so
+        # keeping the futures in a queue preserves the order of events
+        max_pending = 2 * self.n_workers
+
+        def finish(entry):
+            future, context = entry
+            if future is None:
+                return context
+            return self._make_data_event(future.result(), context)
+
+        with ProcessPoolExecutor(max_workers=self.n_workers) as executor:
+            self._executor = executor
+            self._pending_events = deque()
+            pending = self._pending_events
+
+            try:
+                while True:
+                    # events parsed in this process, e.g. calibration events
+                    next_event = self.try_build_event()
+                    if next_event is not None:
+                        pending.append((None, next_event))
+
+                    while pending and (
+                        len(pending) > max_pending
+                        or pending[0][0] is None
+                        or pending[0][0].done()
+                    ):
+                        event = finish(pending.popleft())
+                        if event is not None:
+                            yield event
+
+                    try:
+                        self.next_low_level()
+                    except StopIteration:
+                        break
+
+                while pending:
+                    event = finish(pending.popleft())
+                    if event is not None:
+                        yield event
+            finally:
+                self._executor = None
+                for future, _ in pending:
+                    if future is not None:
+                        future.cancel()
+                pending.clear()
+
+
+def update_monitoring(snapshots, telescope_id, data):
+    '''Replace the `MonitoringSnapshot` of `telescope_id` in `snapshots`
+    by a new one with the previous values updated by `data`'''
+    snapshots[telescope_id] = snapshots.get(telescope_id, EMPTY_MONITORING).updated(data)
+
+
+def _parse_array_event_payload(header, payload, allowed_telescopes, engine='cython'):
+    '''Parse an ArrayEvent from its header and the raw payload bytes.
+    Used by the worker processes of `SimTelFile` with n_workers > 1.
+    '''
+    f = OffsetBytesIO(payload, header.content_address)
+    return parse_array_event(ArrayEvent(header, f), allowed_telescopes, engine=engine)
+
 
-def parse_array_event(array_event, allowed_telescopes=None):
+def parse_array_event(array_event, allowed_telescopes=None, lazy=False, engine='cython'):
     '''structure of event:
         TriggerInformation[2009]  <-- this knows how many TelescopeEvents
 
@@ -331,13 +657,17 @@ def parse_array_event(array_event, allowed_telescopes=None):
             n tel events
             m track events (n does not need to be == m)
             1 shower
+
+        With lazy=True, telescope events are returned as `LazyTelescopeEvent`,
+        `engine` selects the decoders for the adc data, see `eventio.simtel.engines`
     '''
     check_type(array_event, ArrayEvent)
 
     telescope_events = {}
     tracking_positions = {}
 
-    for i, o in enumerate(array_event):
+    subobjects = iter_allowed_subobjects(array_event, allowed_telescopes)
+    for i, o in enumerate(subobjects):
         # require first element to be a TriggerInformation
         if i == 0:
             check_type(o, TriggerInformation)
@@ -348,12 +678,13 @@ def parse_array_event(array_event, allowed_telescopes=None):
                 break
 
         elif isinstance(o, TelescopeEvent):
-            if allowed_telescopes is None or o.telescope_id in allowed_telescopes:
-                telescope_events[o.telescope_id] = parse_telescope_event(o)
+            if lazy:
+                telescope_events[o.telescope_id] = LazyTelescopeEvent(o, engine=engine)
+            else:
+                telescope_events[o.telescope_id] = parse_telescope_event(o, engine=engine)
 
         elif isinstance(o, TrackingPosition):
-            if allowed_telescopes is None or o.telescope_id in allowed_telescopes:
-                tracking_positions[o.telescope_id] = o.parse()
+            tracking_positions[o.telescope_id] = o.parse()
 
     missing_tracking = set(telescope_events.keys()) - set(tracking_positions.keys())
     if missing_tracking:
@@ -370,14 +701,49 @@ def parse_array_event(array_event, allowed_telescopes=None):
     }
 
 
-def parse_telescope_data(telescope_data):
-    ''' Parse the TelescopeData block with Cherenkov Photon information'''
+def iter_allowed_subobjects(container, allowed_telescopes=None):
+    '''Iterate over the subobjects of `container`, skipping
+    telescope events and tracking positions of telescopes not in
+    `allowed_telescopes` based on their header, without creating objects
+    for them or reading their payload.
+    '''
+    while True:
+        try:
+            header = container.next_header()
+        except StopIteration:
+            return
+
+        if allowed_telescopes is not None:
+            cls = KNOWN_OBJECTS.get(header.type)
+            if cls is TelescopeEvent or cls is TrackingPosition:
+                if cls.type_to_telid(header.type) not in allowed_telescopes:
+                    continue
+
+        yield container.object_from_header(header)
+
+
+def parse_telescope_data(telescope_data, allowed_telescopes=None):
+    '''Parse the TelescopeData block with Cherenkov Photon information
+
+    The photons and photo electrons are stored by telescope index,
+    which is the telescope id - 1.
+    If `allowed_telescopes` is given, the data of all other telescopes
+    is skipped without parsing it.
+    '''
     check_type(telescope_data, iact.TelescopeData)
 
     photons = {}
     emitter = {}
     photo_electrons = {}
     for o in telescope_data:
+        telescope_id = getattr(o, 'telescope_id', None)
+        if (
+            allowed_telescopes
+            and telescope_id is not None
+            and telescope_id + 1 not in allowed_telescopes
+        ):
+            continue
+
         if isinstance(o, iact.PhotoElectrons):
             photo_electrons[o.telescope_id] = o.parse()
         elif isinstance(o, iact.Photons):
@@ -389,8 +755,9 @@ def parse_telescope_data(telescope_data):
     return telescope_data.header.id, photons, emitter, photo_electrons
 
 
-def parse_telescope_event(telescope_event):
-    '''Parse a telescope event'''
+def parse_telescope_event(telescope_event, engine='cython'):
+    '''Parse a telescope event, `engine` selects the decoders for
+    the adc data, see `eventio.simtel.engines`'''
     check_type(telescope_event, TelescopeEvent)
 
     event = {'pixel_lists': {}}
@@ -401,10 +768,10 @@ def parse_telescope_event(telescope_event):
             event['header'] = o.parse()
 
         elif isinstance(o, ADCSamples):
-            event['adc_samples'] = o.parse()
+            event['adc_samples'] = o.parse(engine=engine)
 
         elif isinstance(o, ADCSums):
-            event['adc_sums'] = o.parse()
+            event['adc_sums'] = o.parse(engine=engine)
 
         elif isinstance(o, PixelTiming):
             event['pixel_timing'] = o.parse()
@@ -419,3 +786,104 @@ def parse_telescope_event(telescope_event):
             event['pixel_trigger_times'] = o.parse()
 
     return event
+
+
+class LazyTelescopeEvent(Mapping):
+    '''
+    Read-only mapping with the same content as the dict returned by
+    `parse_telescope_event`, but sub-objects are only parsed when
+    their key is accessed for the first time.
+
+    On creation, the payload of the telescope event is kept
+    (without copying for memory mapped files)
+    and only the headers of the sub-objects are read.
+    '''
+    # keys of the sub-objects that appear at most once
+    products = {
+        ADCSamples: 'adc_samples',
+        ADCSums: 'adc_sums',
+        PixelTiming: 'pixel_timing',
+        ImageParameters: 'image_parameters',
+        PixelTriggerTimes: 'pixel_trigger_times',
+    }
+
+    # sub-objects decoded by the selected engine
+    engine_products = (ADCSamples, ADCSums)
+
+    def __init__(self, telescope_event, engine='cython'):
+        check_type(telescope_event, TelescopeEvent)
+        self.telescope_id = telescope_event.telescope_id
+        self.engine = engine
+
+        header = telescope_event.header
+        telescope_event.seek(0)
+        payload = telescope_event.view()
+        if len(payload) < header.content_size:
+            raise EOFError('File seems to be truncated')
+        instrumentation = telescope_event._instrumentation
+        telescope_event = TelescopeEvent(
+            header, OffsetBytesIO(payload, header.content_address)
+        )
+        telescope_event._instrumentation = instrumentation
+
+        self._objects = {}
+        self._pixel_lists = []
+        self._parsed = {}
+
+        for i, o in enumerate(telescope_event):
+            if i == 0:
+                check_type(o, TelescopeEventHeader)
+                self._objects['header'] = o
+            elif isinstance(o, PixelList):
+                self._pixel_lists.append(o)
+            else:
+                key = self.products.get(type(o))
+                if key is not None:
+                    self._objects[key] = o
+
+        self._keys = ['pixel_lists'] + list(self._objects.keys())
+
+    def _parse(self, o):
+        o.seek(0)
+        if isinstance(o, self.engine_products):
+            return o.parse(engine=self.engine)
+        return o.parse()
+
+    def __getitem__(self, key):
+        try:
+            return self._parsed[key]
+        except KeyError:
+            pass
+
+        if key == 'pixel_lists':
+            value = {o.code: self._parse(o) for o in self._pixel_lists}
+        elif key in self._objects:
+            value = self._parse(self._objects[key])
+        else:
+            raise KeyError(key)
+
+        self._parsed[key] = value
+        return value
+
+    def __iter__(self):
+        return iter(self._keys)
+
+    def __len__(self):
+        return len(self._keys)
+
+    def __contains__(self, key):
+        return key in self._keys
+
+    def get_object(self, key):
+        '''The unparsed sub-object for key, e.g. to decode
+        the adc samples into a preallocated buffer'''
+        return self._objects[key]
+
+    def is_parsed(self, key):
+        '''True if the sub-object for key was already parsed'''
+        return key in self._parsed
+
+    def __repr__(self):
+        return '{}(telescope_id={}, keys={})'.format(
+            self.__class__.__name__, self.telescope_id, self._keys
+        )
@@ -0,0 +1,476 @@
+'''
+Byte sources to read eventio files that are not on a local filesystem.
+
+A `ByteSource` gives random access to the bytes of a (remote) file
+using range requests. `SourceFile` turns it into a seekable, read-only
+file object, that fetches large blocks with several requests in flight,
+so it can be used by the rest of pyeventio like a local file.
+
+Supported are
+
+- http(s) urls, e.g. public or presigned S3 urls, using only the standard library
+- all protocols supported by ``fsspec``, e.g. ``s3://`` (needs ``s3fs``),
+  ``gs://`` (needs ``gcsfs``) or ``root://`` for XRootD (needs ``fsspec-xrootd``)
+
+Everywhere pyeventio accepts a path, a url or a `ByteSource` can be used instead.
+'''
+import calendar
+from collections import OrderedDict
+from concurrent.futures import ThreadPoolExecutor
+import email.utils
+import logging
+import os
+import re
+import threading
+import urllib.error
+import urllib.request
+
+
+__all__ = [
+    'ByteSource',
+    'FSSpecSource',
+    'HTTPSource',
+    'LocalSource',
+    'SourceFile',
+    'as_source',
+    'coalesce_ranges',
+    'fetch_objects',
+    'is_remote',
+    'open_binary',
+]
+
+log = logging.getLogger(__name__)
+
+DEFAULT_BLOCK_SIZE = 4 * 1024**2
+DEFAULT_MAX_IN_FLIGHT = 4
+# ranges closer than this are fetched with a single request
+DEFAULT_MAX_GAP = 1024**2
+# the start of each file is cached for the file type checks
+HEAD_SIZE = 64 * 1024
+MAX_THREADS = 16
+
+_URL_RE = re.compile(r'^[a-zA-Z][a-zA-Z0-9+.\-]*://')
+
+_executor = None
+_executor_lock = threading.Lock()
+
+
+def get_executor():
+    '''Thread pool shared by all sources for the range requests'''
+    global _executor
+    with _executor_lock:
+        if _executor is None:
+            _executor = ThreadPoolExecutor(max_workers=MAX_THREADS)
+        return _executor
+
+
+def is_remote(path):
+    '''True if `path` is a `ByteSource` or a url'''
+    if isinstance(path, ByteSource):
+        return True
+    return isinstance(path, str) and _URL_RE.match(path) is not None
+
+
+def as_source(path, **kwargs):
+    '''Get the `ByteSource` for a url, `kwargs` are passed to the source'''
+    if isinstance(path, ByteSource):
+        return path
+    if path.startswith(('http://', 'https://')):
+        return HTTPSource(path, **kwargs)
+    if path.startswith('file://'):
+        return LocalSource(path[len('file://'):])
+    return FSSpecSource(path, **kwargs)
+
+
+def open_binary(path):
+    '''Open a local path, a url or a `ByteSource` for reading bytes'''
+    if is_remote(path):
+        return as_source(path).open()
+    return open(path, 'rb')
+
+
+def file_stat(path):
+    '''Size and modification time in ns of a local file, url or `ByteSource`.
+    The modification time is None if it is not known.'''
+    if is_remote(path):
+        source = as_source(path)
+        return source.size, source.mtime_ns
+
+    stat = os.stat(path)
+    return stat.st_size, stat.st_mtime_ns
+
+
+def coalesce_ranges(ranges, max_gap=DEFAULT_MAX_GAP):
+    '''Merge byte ranges (start, stop) that overlap or are less than `max_gap`
+    bytes apart.
+
+    Returns
+    -------
+    merged: list of (start, stop, members)
+        members are the indices of the input ranges in the merged range
+    '''
+    order = sorted(range(len(ranges)), key=lambda i: ranges[i][0])
+    merged = []
+    for i in order:
+        start, stop = ranges[i]
+        if merged and start <= merged[-1][1] + max_gap:
+            merged[-1][1] = max(merged[-1][1], stop)
+            merged[-1][2].append(i)
+        else:
+            merged.append([start, stop, [i]])
+    return [tuple(m) for m in merged]
+
+
+class ByteSource:
+    '''
+    Base class for random access to the bytes of a file at `url`.
+
+    Subclasses implement `_stat` and `read_range`, which must be thread safe.
+    '''
+    def __init__(self, url):
+        self.url = url
+        self._stat_result = None
+        self._head = None
+
+    def __str__(self):
+        return self.url
+
+    def __repr__(self):
+        return '{}({!r})'.format(self.__class__.__name__, self.url)
+
+    def _stat(self):
+        '''Return size and modification time in ns (or None)'''
+        raise NotImplementedError
+
+    def read_range(self, start, stop):
+        '''Return the bytes from `start` to `stop` (exclusive)'''
+        raise NotImplementedError
+
+    def with_suffix(self, suffix):
+        '''A source of the same kind for the file at url + suffix'''
+        return self.__class__(self.url + suffix)
+
+    def stat(self):
+        if self._stat_result is None:
+            self._stat_result = self._stat()
+        return self._stat_result
+
+    @property
+    def size(self):
+        return self.stat()[0]
+
+    @property
+    def mtime_ns(self):
+        return self.stat()[1]
+
+    def head(self):
+        '''The first `HEAD_SIZE` bytes of the file, only requested once'''
+        if self._head is None:
+            self._head = self.read_range(0, min(HEAD_SIZE, self.size))
+        return self._head
+
+    def exists(self):
+        try:
+            self.stat()
+        except (FileNotFoundError, PermissionError):
+            # object stores often deny access to objects that do not exist
+            return False
+        return True
+
+    def read_ranges(self, ranges, max_gap=DEFAULT_MAX_GAP):
+        '''Fetch several byte ranges (start, stop), close ranges are merged
+        and all requests are made in parallel.
+        Returns the bytes of each range in the order of `ranges`.'''
+        merged = coalesce_ranges(ranges, max_gap=max_gap)
+        futures = [
+            get_executor().submit(self.read_range, start, stop)
+            for start, stop, _ in merged
+        ]
+
+        result = [None] * len(ranges)
+        for (start, _, members), future in zip(merged, futures):
+            data = memoryview(future.result())
+            for i in members:
+                range_start, range_stop = ranges[i]
+                result[i] = data[range_start - start:range_stop - start].tobytes()
+        return result
+
+    def open(self, block_size=DEFAULT_BLOCK_SIZE, max_in_flight=DEFAULT_MAX_IN_FLIGHT):
+        return SourceFile(self, block_size=block_size, max_in_flight=max_in_flight)
+
+
+class LocalSource(ByteSource):
+    '''`ByteSource` for a local file, mainly for testing'''
+    def __init__(self, url):
+        if url.startswith('file://'):
+            url = url[len('file://'):]
+        super().__init__(url)
+
+    def _stat(self):
+        stat = os.stat(self.url)
+        return stat.st_size, stat.st_mtime_ns
+
+    def read_range(self, start, stop):
+        with open(self.url, 'rb') as f:
+            f.seek(start)
+            return f.read(max(stop - start, 0))
+
+
+class HTTPSource(ByteSource):
+    '''
+    `ByteSource` for files served via http(s), using range requests.
+
+    Parameters
+    ----------
+    url: str
+        The url of the file
+    headers: dict
+        Additional http headers, e.g. for authentication
+    timeout: float
+        Timeout of the requests in seconds
+    '''
+    def __init__(self, url, headers=None, timeout=60):
+        super().__init__(url)
+        self.headers = dict(headers or {})
+        self.timeout = timeout
+
+    def with_suffix(self, suffix):
+        # keep query parameters at the end of the url
+        url, sep, query = self.url.partition('?')
+        return HTTPSource(url + suffix + sep + query, self.headers, self.timeout)
+
+    def _request(self, method='GET', byte_range=None):
+        headers = dict(self.headers)
+        if byte_range is not None:
+            headers['Range'] = 'bytes={}-{}'.format(*byte_range)
+
+        request = urllib.request.Request(self.url, headers=headers, method=method)
+        try:
+            return urllib.request.urlopen(request, timeout=self.timeout)
+        except urllib.error.HTTPError as e:
+            if e.code == 404:
+                raise FileNotFoundError('{} not found'.format(self.url)) from None
+            if e.code in (401, 403):
+                raise PermissionError('Access to {} denied'.format(self.url)) from None
+            raise
+
+    def _stat(self):
+        # not all servers (e.g. presigned S3 urls) allow HEAD requests,
+        # so we request the first byte and look at the Content-Range
+        with self._request(byte_range=(0, 0)) as response:
+            content_range = response.headers.get('Content-Range')
+            if response.status != 206 or content_range is None:
+                raise IOError('Server does not support range requests for {}'.format(self.url))
+            size = int(content_range.rpartition('/')[2])
+            last_modified = response.headers.get('Last-Modified')
+
+        mtime_ns = None
+        if last_modified is not None:
+            parsed = email.utils.parsedate(last_modified)
+            if parsed is not None:
+                mtime_ns = calendar.timegm(parsed) * 10**9
+        return size, mtime_ns
+
+    def read_range(self, start, stop):
+        if stop <= start:
+            return b''
+
+        with self._request(byte_range=(start, stop - 1)) as response:
+            if response.status != 206:
+                raise IOError('Server does not support range requests for {}'.format(self.url))
+            return response.read()
+
+
+class FSSpecSource(ByteSource):
+    '''
+    `ByteSource` using ``fsspec``, e.g. for ``s3://``, ``gs://``
+    or ``root://`` (XRootD) urls.
+
+    `storage_options` are passed to the fsspec filesystem.
+    '''
+    def __init__(self, url, **storage_options):
+        try:
+            import fsspec
+        except ImportError:
+            raise IOError(
+                'You need to install `fsspec` to read files from {}'.format(url)
+            ) from None
+
+        super().__init__(url)
+        self.storage_options = storage_options
+        self.fs, self._path = fsspec.core.url_to_fs(url, **storage_options)
+
+    def with_suffix(self, suffix):
+        return FSSpecSource(self.url + suffix, **self.storage_options)
+
+    def _stat(self):
+        info = self.fs.info(self._path)
+        mtime = info.get('mtime', info.get('LastModified'))
+        if hasattr(mtime, 'timestamp'):
+            mtime = mtime.timestamp()
+        mtime_ns = int(mtime * 10**9) if mtime is not None else None
+        return info['size'], mtime_ns
+
+    def read_range(self, start, stop):
+        if stop <= start:
+            return b''
+        return self.fs.cat_file(self._path, start=start, end=stop)
+
+
+class SourceFile:
+    '''
+    Seekable, read-only file object for a `ByteSource`.
+
+    Data is fetched in blocks of `block_size` bytes. Reads spanning several
+    blocks fetch all of them in parallel and when reading sequentially,
+    the next `max_in_flight - 1` blocks are requested in advance.
+    The most recently used blocks are kept, so seeking back a bit is cheap.
+    '''
+    def __init__(self, source, block_size=DEFAULT_BLOCK_SIZE, max_in_flight=DEFAULT_MAX_IN_FLIGHT):
+        if block_size <= 0:
+            raise ValueError('block_size must be positive')
+        if max_in_flight < 1:
+            raise ValueError('max_in_flight must be at least 1')
+
+        self.source = source
+        self.name = source.url
+        self.block_size = block_size
+        self.max_in_flight = max_in_flight
+        self.size = source.size
+        self.closed = False
+
+        self._pos = 0
+        self._blocks = OrderedDict()
+        self._max_blocks = 2 * max_in_flight + 1
+        self._last_block = None
+
+    @property
+    def n_blocks(self):
+        return (self.size + self.block_size - 1) // self.block_size
+
+    def _request(self, block):
+        future = self._blocks.get(block)
+        if future is None:
+            start = block * self.block_size
+            stop = min(start + self.block_size, self.size)
+            future = get_executor().submit(self.source.read_range, start, stop)
+            self._blocks[block] = future
+        self._blocks.move_to_end(block)
+        return future
+
+    def _evict(self):
+        while len(self._blocks) > self._max_blocks:
+            _, future = self._blocks.popitem(last=False)
+            future.cancel()
+
+    def read(self, size=-1):
+        if self.closed:
+            raise ValueError('I/O operation on closed file')
+
+        if size is None or size < 0 or self._pos + size > self.size:
+            size = max(self.size - self._pos, 0)
+        if size == 0:
+            return b''
+
+        if self._pos + size <= HEAD_SIZE and self._last_block is None:
+            data = self.source.head()[self._pos:self._pos + size]
+            if len(data) == size:
+                self._pos += size
+                return data
+
+        first = self._pos // self.block_size
+        last = (self._pos + size - 1) // self.block_size
+
+        sequential = self._last_block is not None and first in (self._last_block, self._last_block + 1)
+        n_ahead = self.max_in_flight - 1 if sequential else 0
+        stop_block = min(last + n_ahead, self.n_blocks - 1)
+
+        # request all blocks, also the prefetched ones, before waiting for any
+        futures = [self._request(block) for block in range(first, stop_block + 1)]
+
+        parts = []
+        remaining = size
+        offset = self._pos - first * self.block_size
+        for future in futures[:last - first + 1]:
+            data = future.result()
+            part = data[offset:offset + remaining]
+            if not part:
+                raise EOFError('Source {} returned less data than expected'.format(self.name))
+            parts.append(part)
+            remaining -= len(part)
+            offset = 0
+
+        self._last_block = last
+        self._evict()
+        self._pos += size
+        return b''.join(parts) if len(parts) > 1 else parts[0]
+
+    def seek(self, offset, whence=0):
+        if whence == 0:
+            pos = offset
+        elif whence == 1:
+            pos = self._pos + offset
+        elif whence == 2:
+            pos = self.size + offset
+        else:
+            raise ValueError(
+                'invalid whence ({}, should be 0, 1 or 2)'.format(whence)
+            )
+        if pos < 0:
+            raise ValueError('negative seek position {}'.format(pos))
+        self._pos = pos
+        return self._pos
+
+    def tell(self):
+        return self._pos
+
+    def readable(self):
+        return True
+
+    def seekable(self):
+        return True
+
+    def close(self):
+        for future in self._blocks.values():
+            future.cancel()
+        self._blocks.clear()
+        self.closed = True
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+
+def fetch_objects(path, rows, max_gap=DEFAULT_MAX_GAP):
+    '''
+    Read only the objects described by the index `rows`
+    (see `eventio.index.EventIOIndex`) from an uncompressed file,
+    requesting the byte ranges of close objects together and all in parallel.
+
+    Returns a list of `EventIOObject`, in the order of `rows`,
+    backed by the data in memory.
+    '''
+    from .base import KNOWN_OBJECTS, EventIOObject, OffsetBytesIO, read_header, read_sync_marker
+
+    source = as_source(path) if is_remote(path) else LocalSource(path)
+    ranges = [
+        (int(row['offset']), int(row['offset']) + int(row['header_size']) + int(row['size']))
+        for row in rows
+    ]
+
+    objects = []
+    for row, (start, _), data in zip(rows, ranges, source.read_ranges(ranges, max_gap)):
+        f = OffsetBytesIO(data, start)
+        toplevel = row['depth'] == 0
+        if toplevel:
+            read_sync_marker(f)
+        header = read_header(f, offset=start, toplevel=toplevel)
+        if header.type != row['type']:
+            raise ValueError(
+                'Expected object of type {} at {}, got {}'.format(row['type'], start, header.type)
+            )
+        cls = KNOWN_OBJECTS.get(header.type, EventIOObject)
+        objects.append(cls(header, filehandle=f))
+    return objects
@@ -100,3 +100,27 @@ def read_unsigned_varint(f):
         var_int_bytes += f.read(var_int_length - 1)
 
     return parse_varint(var_int_bytes)
+
+
+def encode_unsigned_varint(value):
+    '''Encode a non-negative python integer as unsigned varint,
+    the inverse of `read_unsigned_varint`'''
+    for length in range(1, 9):
+        if value < 2**(7 * length):
+            break
+    else:
+        return b'\xff' + value.to_bytes(8, 'big')
+
+    if length == 8:
+        return b'\xfe' + value.to_bytes(7, 'big')
+
+    # length - 1 leading ones in the first byte
+    prefix = (0xff << (9 - length)) & 0xff
+    rest = value & (2**(8 * (length - 1)) - 1)
+    first = prefix | (value >> (8 * (length - 1)))
+    return bytes([first]) + rest.to_bytes(length - 1, 'big')
+
+
+def encode_varint(value):
+    '''Encode a python integer as signed varint, the inverse of `read_varint`'''
+    return encode_unsigned_varint(2 * value if value >= 0 else -2 * value - 1)
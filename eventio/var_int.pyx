@@ -1,12 +1,32 @@
 # cython: language_level=3
 import cython
+from collections.abc import Sequence
 import numpy as np
 cimport numpy as cnp
 from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t, int16_t, int32_t, int64_t
 from libc.math cimport NAN
+from libc.string cimport memcpy, memset
+from eventio.var_int_kernels cimport (
+    STATUS_OK,
+    STATUS_BUFFER_OVERRUN,
+    STATUS_INDEX_OUT_OF_RANGE,
+    buffer_pointer,
+    check_status,
+    EVENTIO_VARINT_SIMD,
+    decode_unsigned_varint_differential,
+    decode_unsigned_varint_differential_scalar,
+    read_float,
+    read_int16,
+    read_int32,
+    read_unsigned_varint,
+    read_varint,
+)
 
 cnp.import_array()
 
+#: instruction set used for decoding differentially encoded arrays
+SIMD_INSTRUCTION_SET = EVENTIO_VARINT_SIMD.decode('ascii')
+
 
 @cython.wraparound(False)  # disable negative indexing
 cpdef (uint64_t, uint8_t) unsigned_varint(const uint8_t[:] data, uint64_t offset=0):
@@ -126,183 +146,173 @@ cpdef uint64_t parse_varint(const uint8_t[:] var_int_bytes):
     )
 
 
+@cython.boundscheck(False)
 @cython.wraparound(False)  # disable negative indexing
 cpdef unsigned_varint_array(
-    const uint8_t[:] data,
+    const uint8_t[::1] data,
     uint64_t n_elements,
     uint64_t offset = 0,
 ):
     cdef cnp.npy_intp[1] shape = [n_elements]
     cdef cnp.ndarray[uint64_t, ndim=1] output = cnp.PyArray_SimpleNew(1, shape, cnp.NPY_UINT64)
+    cdef uint64_t* out = <uint64_t*> cnp.PyArray_DATA(output)
 
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
     cdef uint64_t i
-    cdef uint64_t length
     cdef uint64_t pos = offset
+    cdef int status = STATUS_OK
 
-    for i in range(n_elements):
-        length = get_length_of_varint(data[pos])
-        output[i] = parse_varint(data[pos:pos + length])
-        pos += length
+    with nogil:
+        for i in range(n_elements):
+            status = read_unsigned_varint(ptr, size, &pos, &out[i])
+            if status != STATUS_OK:
+                break
 
+    check_status(status)
     return output, pos - offset
 
 
+@cython.boundscheck(False)
 @cython.wraparound(False)  # disable negative indexing
 cpdef varint_array(
-    const uint8_t[:] data,
+    const uint8_t[::1] data,
     uint64_t n_elements,
     uint64_t offset = 0,
 ):
     cdef cnp.npy_intp[1] shape = [n_elements];
     cdef cnp.ndarray[int64_t, ndim=1] output = cnp.PyArray_SimpleNew(1, shape, cnp.NPY_INT64)
+    cdef int64_t* out = <int64_t*> cnp.PyArray_DATA(output)
 
-    cdef int64_t val
-    cdef uint8_t length
-
-    cdef uint8_t one = 1;
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
     cdef uint64_t i
     cdef uint64_t pos = offset
+    cdef int status = STATUS_OK
 
-    for i in range(n_elements):
-        length = get_length_of_varint(data[pos])
-        val = parse_varint(data[pos:pos + length])
-        pos += length
-
-        if (val & one):
-            output[i] = -(val >> one) - one
-        else:
-            output[i] = val >> one
+    with nogil:
+        for i in range(n_elements):
+            status = read_varint(ptr, size, &pos, &out[i])
+            if status != STATUS_OK:
+                break
 
+    check_status(status)
     return output, pos - offset
 
 
+@cython.boundscheck(False)
 @cython.wraparound(False)  # disable negative indexing
 cpdef unsigned_varint_arrays_differential(
-    const uint8_t[:] data,
+    const uint8_t[::1] data,
     uint64_t n_arrays,
     uint64_t n_elements,
     uint64_t offset = 0,
+    bint simd = True,
 ):
-    cdef uint64_t pos = 0
-    cdef uint64_t bytes_read = 0
-    cdef uint64_t bytes_read_total = 0
-    cdef uint64_t i
-    cdef uint64_t j
+    '''Decode `n_arrays` arrays of `n_elements` differentially encoded varints.
 
+    With `simd=False`, the scalar reference implementation is used.
+    '''
     cdef cnp.npy_intp[2] shape = [n_arrays, n_elements]
     cdef cnp.ndarray[uint32_t, ndim=2] output = cnp.PyArray_SimpleNew(2, shape, cnp.NPY_UINT32)
-    cdef uint32_t[:, :] output_view = output
-    cdef uint32_t[:] output_view_1d
+    cdef uint32_t* out = <uint32_t*> cnp.PyArray_DATA(output)
 
-    for i in range(n_arrays):
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef uint64_t i
+    cdef uint64_t pos = offset
+    cdef int status = STATUS_OK
 
-        output_view_1d = output_view[i]
+    with nogil:
+        for i in range(n_arrays):
+            if simd:
+                status = decode_unsigned_varint_differential(
+                    ptr, size, &pos, out + i * n_elements, n_elements
+                )
+            else:
+                status = decode_unsigned_varint_differential_scalar(
+                    ptr, size, &pos, out + i * n_elements, n_elements
+                )
+            if status != STATUS_OK:
+                break
 
-        bytes_read = unsigned_varint_array_differential(
-            data, output=output_view_1d, offset=offset
-        )
-        offset += bytes_read
-        bytes_read_total += bytes_read
+    check_status(status)
+    return output, pos - offset
 
-    return output, bytes_read_total
 
+@cython.boundscheck(False)
+@cython.wraparound(False)
+cdef int parse_pixel_timing(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    uint32_t i_pix,
+    uint32_t n_gains,
+    uint32_t n_pixels,
+    uint32_t n_types,
+    bint with_sum,
+    bint glob_only_selected,
+    float granularity,
+    float* timval,
+    int32_t* pulse_sum_loc,
+    int32_t* pulse_sum_glob,
+) nogil:
+    cdef uint32_t i_type, i_gain
+    cdef int16_t time
+    cdef int64_t value
+    cdef int status
+
+    if i_pix >= n_pixels:
+        return STATUS_INDEX_OUT_OF_RANGE
+
+    for i_type in range(n_types):
+        status = read_int16(data, size, pos, &time)
+        if status != STATUS_OK:
+            return status
+        timval[i_pix * n_types + i_type] = granularity * time
+
+    if with_sum:
+        for i_gain in range(n_gains):
+            status = read_varint(data, size, pos, &value)
+            if status != STATUS_OK:
+                return status
+            pulse_sum_loc[i_gain * n_pixels + i_pix] = value
 
-@cython.wraparound(False)  # disable negative indexing
-cdef uint64_t unsigned_varint_array_differential(
-    const uint8_t[:] data,
-    uint32_t[:] output,
-    uint64_t offset = 0,
-) except -1:
+        if glob_only_selected:
+            for i_gain in range(n_gains):
+                status = read_varint(data, size, pos, &value)
+                if status != STATUS_OK:
+                    return status
+                pulse_sum_glob[i_gain * n_pixels + i_pix] = value
+
+    return STATUS_OK
 
-    cdef uint64_t n_elements = output.shape[0]
-    cdef int32_t val = 0
+
+cdef int parse_global_pulse_sums(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    uint32_t n_gains,
+    uint32_t n_pixels,
+    int32_t* pulse_sum_glob,
+) nogil:
     cdef uint64_t i
-    cdef uint64_t pos = 0
-    cdef uint8_t v0, v1, v2, v3, v4
-
-    for i in range(n_elements):
-        v0 = data[pos + offset]
-        pos += 1
-
-        if (v0 & 0x80) == 0:  # one byte
-            if (v0 & 0x01) == 0:  # positive
-                val += v0 >> 1
-            else:  # negative
-                val -= (v0 >> 1) + 1
-        elif (v0 & 0xc0) == 0x80:  # two bytes
-            v1 = data[pos + offset]
-            pos += 1
-            if (v1 & 0x01) == 0:  # positive
-                val += ((v0 & 0x3f) << 7) | (v1 >> 1)
-            else:  # negative
-                val -= (((v0 & 0x3f) << 7) | (v1 >> 1)) + 1
-        elif (v0 & 0xe0) == 0xc0:  # three bytes
-            v1 = data[pos + offset + 0]
-            v2 = data[pos + offset + 1]
-            pos += 2
-
-            if (v2 & 0x01) == 0:
-                val += (
-                    ((v0 & 0x1f) << 15)
-                    | (v1 << 7)
-                    | (v2 >> 1)
-                )
-            else:
-                val -= (
-                    ((v0 & 0x1f) << 15)
-                    | (v1 << 7)
-                    | (v2 >> 1)
-                ) + 1
-        elif (v0 & 0xf0) == 0xe0:  # four bytes
-            v1 = data[pos + offset + 0]
-            v2 = data[pos + offset + 1]
-            v3 = data[pos + offset + 2]
-            pos += 3
-            if (v3 & 0x01) == 0:
-                val += (
-                    ((v0 & 0x0f) << 23)
-                    | (v1 << 15)
-                    | (v2 << 7)
-                    | (v3 >> 1)
-                )
-            else:
-                val -= (
-                    ((v0 & 0x0f) << 23)
-                    | (v1 << 15)
-                    | (v2 << 7)
-                    | (v3 >> 1)
-                ) + 1
-        elif (v0 & 0xf8) == 0xf0:
-            v1 = data[pos + offset + 0]
-            v2 = data[pos + offset + 1]
-            v3 = data[pos + offset + 2]
-            v4 = data[pos + offset + 3]
-            pos += 4
-            # The format would allow bits 32 and 33 being set but we ignore this here. */
-            if (v4 & 0x01) == 0:
-                val += (
-                    ((v0 & 0x07) << 31)
-                    | (v1 << 23)
-                    | (v2 << 15)
-                    | (v3 << 7)
-                    | (v4 >> 1)
-                )
-            else:
-                val -= (
-                    ((v0 & 0x07) << 31)
-                    | (v1 << 23)
-                    | (v2 << 15)
-                    | (v3 << 7)
-                    | (v4 >> 1)
-                ) + 1
-        output[i] = val
+    cdef int64_t value
+    cdef int status
 
-    return pos
+    for i in range(<uint64_t> n_gains * n_pixels):
+        status = read_varint(data, size, pos, &value)
+        if status != STATUS_OK:
+            return status
+        pulse_sum_glob[i] = value
 
+    return STATUS_OK
 
 
+@cython.boundscheck(False)
+@cython.wraparound(False)
 def simtel_pixel_timing_parse_list_type_2(
-    const uint8_t[:] data,
+    const uint8_t[::1] data,
     const int16_t[:, :] pixel_list,
     uint32_t n_gains,
     uint32_t n_pixels,
@@ -311,12 +321,13 @@ def simtel_pixel_timing_parse_list_type_2(
     bint glob_only_selected,
     float granularity,
 ):
-    cdef int16_t start, stop
+    cdef int32_t start, stop, i_pix
     cdef uint32_t list_index
     cdef uint32_t n_lists = pixel_list.shape[0]
-    cdef uint32_t i_pix, i_type
     cdef uint64_t pos = 0
-    cdef uint32_t length = 0
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef int status = STATUS_OK
 
     cdef cnp.npy_intp[2] shape = (n_pixels, n_types)
     cdef cnp.ndarray[float, ndim=2] timval = cnp.PyArray_SimpleNew(2, shape, cnp.NPY_FLOAT32)
@@ -326,30 +337,34 @@ def simtel_pixel_timing_parse_list_type_2(
     cdef cnp.ndarray[int32_t, ndim=2] pulse_sum_loc = cnp.PyArray_ZEROS(2, shape, cnp.NPY_INT32, False)
     cdef cnp.ndarray[int32_t, ndim=2] pulse_sum_glob = cnp.PyArray_ZEROS(2, shape, cnp.NPY_INT32, False)
 
-    for list_index in range(n_lists):
-        start = pixel_list[list_index][0]
-        stop = pixel_list[list_index][1]
+    cdef float* timval_ptr = <float*> cnp.PyArray_DATA(timval)
+    cdef int32_t* loc_ptr = <int32_t*> cnp.PyArray_DATA(pulse_sum_loc)
+    cdef int32_t* glob_ptr = <int32_t*> cnp.PyArray_DATA(pulse_sum_glob)
+
+    with nogil:
+        for list_index in range(n_lists):
+            start = pixel_list[list_index, 0]
+            stop = pixel_list[list_index, 1]
+            if start < 0:
+                status = STATUS_INDEX_OUT_OF_RANGE
+                break
+
+            for i_pix in range(start, stop + 1):
+                status = parse_pixel_timing(
+                    ptr, size, &pos, i_pix, n_gains, n_pixels, n_types,
+                    with_sum, glob_only_selected, granularity,
+                    timval_ptr, loc_ptr, glob_ptr,
+                )
+                if status != STATUS_OK:
+                    break
 
-        for i_pix in range(start, stop + 1):
-            for i_type in range(n_types):
-                timval[i_pix, i_type] = granularity * (<int16_t*> &data[pos])[0]
-                pos += 2
+            if status != STATUS_OK:
+                break
 
-            if with_sum:
-                for i_gain in range(n_gains):
-                    pulse_sum_loc[i_gain, i_pix], length = varint(data, offset=pos)
-                    pos += length
+        if status == STATUS_OK and with_sum and n_lists > 0 and not glob_only_selected:
+            status = parse_global_pulse_sums(ptr, size, &pos, n_gains, n_pixels, glob_ptr)
 
-                if glob_only_selected:
-                    for i_gain in range(n_gains):
-                        pulse_sum_glob[i_gain, i_pix], length = varint(data, offset=pos)
-                        pos += length
-
-    if with_sum and pixel_list.shape[0] > 0 and not glob_only_selected:
-        for i_gain in range(n_gains):
-            for i_pix in range(n_pixels):
-                pulse_sum_glob[i_gain, i_pix], length = varint(data, offset=pos)
-                pos += length
+    check_status(status)
 
     return {
         'time': timval,
@@ -358,91 +373,405 @@ def simtel_pixel_timing_parse_list_type_2(
     }, pos
 
 
-def parse_1208(
-    const uint8_t[:] data,
+cdef int decode_1208_header(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    uint32_t version,
+    int32_t* n_pe,
+    int32_t* n_pixels,
+    int16_t* flags,
+    int32_t* non_empty,
+) nogil:
+    cdef int status = read_int32(data, size, pos, n_pe)
+    if status == STATUS_OK:
+        status = read_int32(data, size, pos, n_pixels)
+
+    flags[0] = 0
+    if status == STATUS_OK and version > 1:
+        status = read_int16(data, size, pos, flags)
+
+    if status == STATUS_OK:
+        status = read_int32(data, size, pos, non_empty)
+
+    if status == STATUS_OK and (n_pe[0] < 0 or n_pixels[0] < 0 or non_empty[0] < 0):
+        status = STATUS_INDEX_OUT_OF_RANGE
+    return status
+
+
+cdef int decode_1208_pixels(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
     uint32_t n_pixels,
-    uint32_t nonempty,
+    uint32_t non_empty,
     uint32_t version,
-    uint32_t flags,
-    uint32_t total_n_pe
-):
+    bint has_amplitudes,
+    uint64_t total_n_pe,
+    int32_t* photoelectrons,
+    uint32_t* pixel_id,
+    float* time,
+    float* amplitude,
+    bint* pixels_sorted,
+    uint64_t* n_decoded,
+) nogil:
+    # Decode the photo electrons of all non empty pixels.
+    # `photoelectrons` (n_pixels) has to be zeroed, the other outputs
+    # are written for all total_n_pe entries, entries not in the data are set to 0.
+    # The number of photo electrons actually in the data is stored in n_decoded.
+    # If amplitude is NULL, amplitudes in the data are skipped.
+    cdef uint64_t i_pe = 0
+    cdef uint64_t j
+    cdef uint32_t i
+    cdef int32_t n_pe
+    cdef int64_t pix_id
+    cdef int64_t last_pix_id = -1
+    cdef int16_t short_pix_id
+    cdef int status = STATUS_OK
+
+    pixels_sorted[0] = True
+    for i in range(non_empty):
+        if version > 2:
+            status = read_varint(data, size, pos, &pix_id)
+        else:
+            status = read_int16(data, size, pos, &short_pix_id)
+            pix_id = short_pix_id
+        if status != STATUS_OK:
+            return status
 
-    cdef uint32_t length
+        status = read_int32(data, size, pos, &n_pe)
+        if status != STATUS_OK:
+            return status
 
-    cdef cnp.npy_intp[1] pixel_shape = [n_pixels]
-    cdef cnp.ndarray[int32_t, ndim=1] photoelectrons = cnp.PyArray_ZEROS(1, pixel_shape, cnp.NPY_INT32, False)
-    cdef cnp.ndarray[int32_t, ndim=1] photon_counts = None
+        if pix_id < 0 or pix_id >= n_pixels or n_pe < 0 or i_pe + n_pe > total_n_pe:
+            return STATUS_INDEX_OUT_OF_RANGE
 
-    cdef cnp.npy_intp[1] pe_shape = [total_n_pe]
-    cdef cnp.ndarray[uint32_t, ndim=1] pixel_id = cnp.PyArray_ZEROS(1, pe_shape, cnp.NPY_UINT32, False)
-    cdef cnp.ndarray[float, ndim=1] time = cnp.PyArray_ZEROS(1, pe_shape, cnp.NPY_FLOAT32, False)
-    cdef cnp.ndarray[float, ndim=1] amplitude = cnp.PyArray_ZEROS(1, pe_shape, cnp.NPY_FLOAT32, False)
+        if pix_id <= last_pix_id:
+            pixels_sorted[0] = False
+        last_pix_id = pix_id
+        photoelectrons[pix_id] += n_pe
 
-    cdef bint has_amplitudes = flags & 1
-    cdef bint has_photons = flags & 4
+        if pos[0] + 4 * <uint64_t> n_pe > size:
+            return STATUS_BUFFER_OVERRUN
+        memcpy(time + i_pe, data + pos[0], 4 * <uint64_t> n_pe)
+        pos[0] += 4 * <uint64_t> n_pe
 
-    cdef uint64_t pos = 0
-    cdef uint64_t i_pe = 0
-    cdef uint32_t i
-    cdef int32_t j
-    cdef dict result = {}
-    cdef float t
+        for j in range(<uint64_t> n_pe):
+            pixel_id[i_pe + j] = <uint32_t> pix_id
 
+        if has_amplitudes:
+            if pos[0] + 4 * <uint64_t> n_pe > size:
+                return STATUS_BUFFER_OVERRUN
+            if amplitude != NULL:
+                memcpy(amplitude + i_pe, data + pos[0], 4 * <uint64_t> n_pe)
+            pos[0] += 4 * <uint64_t> n_pe
 
-    for i in range(nonempty):
-        if version > 2:
-            pix_id, length = varint(data, offset=pos)
-        else:
-            pix_id = (<int16_t*> &data[pos])[0]
-            length = 2
+        i_pe += n_pe
 
-        pos += length
+    if i_pe < total_n_pe:
+        memset(time + i_pe, 0, 4 * (total_n_pe - i_pe))
+        memset(pixel_id + i_pe, 0, 4 * (total_n_pe - i_pe))
+        if amplitude != NULL:
+            memset(amplitude + i_pe, 0, 4 * (total_n_pe - i_pe))
 
-        n_pe = (<int32_t*> &data[pos])[0]
-        pos += 4
+    n_decoded[0] = i_pe
+    return STATUS_OK
 
-        photoelectrons[pix_id] = n_pe
 
-        for j in range(n_pe):
-            t = (<float*> &data[pos])[0]
-            pixel_id[i_pe + j] = pix_id
-            time[i_pe + j] = t
-            pos += 4
+cdef int decode_1208_photons(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    uint32_t n_pixels,
+    int32_t* photons,
+) nogil:
+    # photons (n_pixels) has to be zeroed
+    cdef int32_t n_photon_pixels
+    cdef int32_t j
+    cdef int16_t short_pix_id
+    cdef int status = read_int32(data, size, pos, &n_photon_pixels)
+    if status != STATUS_OK:
+        return status
+
+    for j in range(n_photon_pixels):
+        status = read_int16(data, size, pos, &short_pix_id)
+        if status != STATUS_OK:
+            return status
+        if short_pix_id < 0 or short_pix_id >= n_pixels:
+            return STATUS_INDEX_OUT_OF_RANGE
+        status = read_int32(data, size, pos, &photons[short_pix_id])
+        if status != STATUS_OK:
+            return status
+
+    return STATUS_OK
+
+
+cdef cnp.ndarray new_array(uint64_t n, int typenum, bint zero):
+    cdef cnp.npy_intp[1] shape = [n]
+    if zero:
+        return cnp.PyArray_ZEROS(1, shape, typenum, False)
+    return cnp.PyArray_SimpleNew(1, shape, typenum)
+
+
+def _sort_by_pixel(result, keys, uint64_t start, uint64_t stop):
+    # pixels appear in ascending order in all known files,
+    # only for other files, the entries have to be grouped by pixel
+    order = start + np.argsort(result['pixel_id'][start:stop], kind='stable')
+    for key in keys:
+        if key in result:
+            result[key][start:stop] = result[key][order]
+
+
+cdef dict _parse_1208(
+    const uint8_t* ptr,
+    uint64_t size,
+    uint64_t* pos,
+    uint32_t n_pixels,
+    uint32_t nonempty,
+    uint32_t version,
+    uint32_t flags,
+    uint64_t total_n_pe,
+):
+    cdef bint has_amplitudes = flags & 1
+    cdef bint has_photons = flags & 4
+    cdef bint pixels_sorted
+    cdef uint64_t n_decoded = 0
+    cdef int status
+
+    cdef cnp.ndarray photoelectrons = new_array(n_pixels, cnp.NPY_INT32, True)
+    cdef cnp.ndarray pixel_id = new_array(total_n_pe, cnp.NPY_UINT32, False)
+    cdef cnp.ndarray time = new_array(total_n_pe, cnp.NPY_FLOAT32, False)
+    cdef cnp.ndarray amplitude = None
+    cdef cnp.ndarray photons
+    cdef float* amplitude_ptr = NULL
+    cdef dict result = {}
 
-        if has_amplitudes:
-            for j in range(n_pe):
-                amplitude[i_pe + j] = (<float*> &data[pos])[0]
-                pos += 4
+    if has_amplitudes:
+        amplitude = new_array(total_n_pe, cnp.NPY_FLOAT32, False)
+        amplitude_ptr = <float*> cnp.PyArray_DATA(amplitude)
 
-        i_pe += n_pe
+    cdef int32_t* pe_ptr = <int32_t*> cnp.PyArray_DATA(photoelectrons)
+    cdef uint32_t* pixel_id_ptr = <uint32_t*> cnp.PyArray_DATA(pixel_id)
+    cdef float* time_ptr = <float*> cnp.PyArray_DATA(time)
+
+    with nogil:
+        status = decode_1208_pixels(
+            ptr, size, pos, n_pixels, nonempty, version, has_amplitudes, total_n_pe,
+            pe_ptr, pixel_id_ptr, time_ptr, amplitude_ptr, &pixels_sorted, &n_decoded,
+        )
+    check_status(status)
 
     result['photoelectrons'] = photoelectrons
     result['pixel_id'] = pixel_id
     result['time'] = time
-
     if has_amplitudes:
         result['amplitude'] = amplitude
 
+    # the zero padding after the decoded entries has to stay at the end
+    if not pixels_sorted:
+        _sort_by_pixel(result, ('pixel_id', 'time', 'amplitude'), 0, n_decoded)
+    result['pixel_offsets'] = np.concatenate([[0], np.cumsum(photoelectrons, dtype=np.int64)])
+
     if has_photons:
-        photons = cnp.PyArray_ZEROS(1, pixel_shape, cnp.NPY_INT32, False)
+        photons = new_array(n_pixels, cnp.NPY_INT32, True)
+        with nogil:
+            status = decode_1208_photons(
+                ptr, size, pos, n_pixels, <int32_t*> cnp.PyArray_DATA(photons)
+            )
+        check_status(status)
+        result['photons'] = photons
+
+    return result
 
-        nonempty = (<int32_t*> &data[pos])[0]
-        pos += 4
 
-        for i in range(nonempty):
-            pix_id = (<int16_t*> &data[pos])[0]
-            pos += 2
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def parse_1208(
+    const uint8_t[::1] data,
+    uint32_t n_pixels,
+    uint32_t nonempty,
+    uint32_t version,
+    uint32_t flags,
+    uint32_t total_n_pe
+):
+    '''Decode the pixel data of a PhotoElectrons object (1208),
+    `data` starts after the header fields.
+
+    Returns a dict with the number of photo electrons per pixel,
+    the pixel id, time and, if present, amplitude of each photo electron
+    and, if present, the number of photons per pixel.
+    Photo electrons are grouped by pixel in ascending order,
+    so that ``pixel_offsets`` (n_pixels + 1) gives the range
+    of the photo electrons of each pixel in the flat arrays.
+    '''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t pos = 0
+    return _parse_1208(ptr, data.shape[0], &pos, n_pixels, nonempty, version, flags, total_n_pe)
+
+
+def parse_photoelectrons(const uint8_t[::1] data, uint32_t version):
+    '''Decode the complete payload of a PhotoElectrons object (1208),
+    including the header fields, see `parse_1208` for the result.'''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef uint64_t pos = 0
+    cdef int32_t n_pe, n_pixels, non_empty
+    cdef int16_t flags
+    cdef int status
+
+    with nogil:
+        status = decode_1208_header(ptr, size, &pos, version, &n_pe, &n_pixels, &flags, &non_empty)
+    check_status(status)
+
+    result = {'n_pe': n_pe, 'n_pixels': n_pixels, 'non_empty': non_empty}
+    result.update(_parse_1208(
+        ptr, size, &pos, n_pixels, non_empty, version, <uint16_t> flags, n_pe
+    ))
+    return result
 
-            photons[pix_id] = (<int32_t*> &data[pos])[0]
-            pos += 4
 
+@cython.boundscheck(False)
+@cython.wraparound(False)
+def parse_photoelectrons_merged(payloads, versions):
+    '''Decode the payloads of several PhotoElectrons objects (1208),
+    e.g. all telescopes of one TelescopeData block, into shared flat arrays.
+
+    Returns a dict with per telescope arrays ``n_pe``, ``n_pixels``,
+    ``non_empty``, the offsets of each telescope in the pixel arrays
+    (``telescope_pixel_offsets``) and photo electron arrays
+    (``telescope_pe_offsets``) and the concatenated arrays
+    ``photoelectrons``, ``pixel_offsets`` (into the photo electron arrays),
+    ``pixel_id``, ``time`` and, if any telescope has them, ``amplitude``
+    (NaN for telescopes without) and ``photons`` (0 for telescopes without).
+    '''
+    cdef uint64_t n_telescopes = len(payloads)
+    if len(versions) != n_telescopes:
+        raise ValueError('Got {} versions for {} payloads'.format(len(versions), n_telescopes))
+    cdef uint32_t[::1] versions_view = np.asarray(versions, dtype=np.uint32)
+
+    cdef const uint8_t[::1] data
+    cdef const uint8_t* ptr
+    cdef uint64_t size, pos
+    cdef int32_t n_pe, n_pixels, non_empty
+    cdef int16_t flags
+    cdef int status = STATUS_OK
+    cdef uint64_t i
+    cdef bint pixels_sorted, has_amplitudes
+    cdef uint64_t n_decoded = 0
+
+    cdef cnp.ndarray n_pe_arr = new_array(n_telescopes, cnp.NPY_INT32, False)
+    cdef cnp.ndarray n_pixels_arr = new_array(n_telescopes, cnp.NPY_INT32, False)
+    cdef cnp.ndarray non_empty_arr = new_array(n_telescopes, cnp.NPY_INT32, False)
+    cdef cnp.ndarray flags_arr = new_array(n_telescopes, cnp.NPY_INT16, False)
+    cdef cnp.ndarray body_start = new_array(n_telescopes, cnp.NPY_UINT64, False)
+    cdef cnp.ndarray pixel_start = new_array(n_telescopes + 1, cnp.NPY_INT64, False)
+    cdef cnp.ndarray pe_start = new_array(n_telescopes + 1, cnp.NPY_INT64, False)
+
+    cdef int32_t[::1] n_pe_view = n_pe_arr
+    cdef int32_t[::1] n_pixels_view = n_pixels_arr
+    cdef int32_t[::1] non_empty_view = non_empty_arr
+    cdef int16_t[::1] flags_view = flags_arr
+    cdef uint64_t[::1] body_view = body_start
+    cdef int64_t[::1] pixel_start_view = pixel_start
+    cdef int64_t[::1] pe_start_view = pe_start
+
+    # first pass over the headers to allocate the outputs
+    pixel_start_view[0] = 0
+    pe_start_view[0] = 0
+    for i in range(n_telescopes):
+        data = payloads[i]
+        ptr = buffer_pointer(data)
+        pos = 0
+        status = decode_1208_header(
+            ptr, data.shape[0], &pos, versions_view[i], &n_pe, &n_pixels, &flags, &non_empty
+        )
+        check_status(status)
+        n_pe_view[i] = n_pe
+        n_pixels_view[i] = n_pixels
+        non_empty_view[i] = non_empty
+        flags_view[i] = flags
+        body_view[i] = pos
+        pixel_start_view[i + 1] = pixel_start_view[i] + n_pixels
+        pe_start_view[i + 1] = pe_start_view[i] + n_pe
+
+    cdef uint64_t total_pixels = pixel_start_view[n_telescopes]
+    cdef uint64_t total_pe = pe_start_view[n_telescopes]
+    cdef bint any_amplitudes = np.any(flags_arr & 1)
+    cdef bint any_photons = np.any(flags_arr & 4)
+
+    cdef cnp.ndarray photoelectrons = new_array(total_pixels, cnp.NPY_INT32, True)
+    cdef cnp.ndarray pixel_id = new_array(total_pe, cnp.NPY_UINT32, False)
+    cdef cnp.ndarray time = new_array(total_pe, cnp.NPY_FLOAT32, False)
+    cdef cnp.ndarray amplitude = None
+    cdef cnp.ndarray photons = None
+    cdef int32_t* pe_ptr = <int32_t*> cnp.PyArray_DATA(photoelectrons)
+    cdef uint32_t* pixel_id_ptr = <uint32_t*> cnp.PyArray_DATA(pixel_id)
+    cdef float* time_ptr = <float*> cnp.PyArray_DATA(time)
+    cdef float* amplitude_ptr = NULL
+    cdef int32_t* photons_ptr = NULL
+
+    if any_amplitudes:
+        amplitude = new_array(total_pe, cnp.NPY_FLOAT32, False)
+        amplitude_ptr = <float*> cnp.PyArray_DATA(amplitude)
+    if any_photons:
+        photons = new_array(total_pixels, cnp.NPY_INT32, True)
+        photons_ptr = <int32_t*> cnp.PyArray_DATA(photons)
+
+    result = {
+        'n_pe': n_pe_arr,
+        'n_pixels': n_pixels_arr,
+        'non_empty': non_empty_arr,
+        'telescope_pixel_offsets': pixel_start,
+        'telescope_pe_offsets': pe_start,
+        'photoelectrons': photoelectrons,
+        'pixel_id': pixel_id,
+        'time': time,
+    }
+    if any_amplitudes:
+        result['amplitude'] = amplitude
+    if any_photons:
         result['photons'] = photons
 
+    for i in range(n_telescopes):
+        data = payloads[i]
+        ptr = buffer_pointer(data)
+        size = data.shape[0]
+        pos = body_view[i]
+        has_amplitudes = flags_view[i] & 1
+
+        with nogil:
+            status = decode_1208_pixels(
+                ptr, size, &pos, n_pixels_view[i], non_empty_view[i], versions_view[i],
+                has_amplitudes, n_pe_view[i],
+                pe_ptr + pixel_start_view[i],
+                pixel_id_ptr + pe_start_view[i],
+                time_ptr + pe_start_view[i],
+                amplitude_ptr + pe_start_view[i] if amplitude_ptr != NULL else NULL,
+                &pixels_sorted, &n_decoded,
+            )
+            if status == STATUS_OK and flags_view[i] & 4:
+                status = decode_1208_photons(
+                    ptr, size, &pos, n_pixels_view[i], photons_ptr + pixel_start_view[i],
+                )
+        check_status(status)
+
+        if amplitude_ptr != NULL and not has_amplitudes:
+            amplitude[pe_start_view[i]:pe_start_view[i + 1]] = np.nan
+
+        if not pixels_sorted:
+            _sort_by_pixel(
+                result, ('pixel_id', 'time', 'amplitude'),
+                pe_start_view[i], pe_start_view[i] + n_decoded,
+            )
+
+    result['pixel_offsets'] = np.concatenate([[0], np.cumsum(photoelectrons, dtype=np.int64)])
     return result
 
 
+@cython.boundscheck(False)
+@cython.wraparound(False)
 cpdef simtel_pixel_timing_parse_list_type_1(
-    const uint8_t[:] data,
+    const uint8_t[::1] data,
     const int16_t[:] pixel_list,
     uint32_t n_gains,
     uint32_t n_pixels,
@@ -451,11 +780,13 @@ cpdef simtel_pixel_timing_parse_list_type_1(
     bint glob_only_selected,
     float granularity,
 ):
-    cdef uint32_t start, stop, list_index
     cdef uint32_t pixel_list_length = pixel_list.shape[0]
-    cdef uint32_t i, i_gain, i_type, i_pix
-    cdef uint32_t length = 0
-    cdef int16_t* short_ptr
+    cdef uint32_t i
+    cdef int16_t i_pix
+    cdef uint64_t pos = 0
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
+    cdef int status = STATUS_OK
 
     cdef cnp.npy_intp[2] shape = (n_pixels, n_types)
     cdef cnp.ndarray[float, ndim=2] timval = cnp.PyArray_SimpleNew(2, shape, cnp.NPY_FLOAT32)
@@ -465,31 +796,29 @@ cpdef simtel_pixel_timing_parse_list_type_1(
     cdef cnp.ndarray[int32_t, ndim=2] pulse_sum_loc = cnp.PyArray_ZEROS(2, shape, cnp.NPY_INT32, False)
     cdef cnp.ndarray[int32_t, ndim=2] pulse_sum_glob = cnp.PyArray_ZEROS(2, shape, cnp.NPY_INT32, False)
 
-    cdef uint64_t pos = 0
-    for i in range(pixel_list_length):
-        i_pix = pixel_list[i]
-        for i_type in range(n_types):
-            short_ptr = <int16_t*> &(data[pos])
-            timval[i_pix, i_type] = granularity * short_ptr[0]
-            pos += 2
-
-        if with_sum:
-            for i_gain in range(n_gains):
-                pulse_sum_loc[i_gain, i_pix], length = varint(data, offset=pos)
-                pos += length
+    cdef float* timval_ptr = <float*> cnp.PyArray_DATA(timval)
+    cdef int32_t* loc_ptr = <int32_t*> cnp.PyArray_DATA(pulse_sum_loc)
+    cdef int32_t* glob_ptr = <int32_t*> cnp.PyArray_DATA(pulse_sum_glob)
 
-            if glob_only_selected:
-                for i_gain in range(n_gains):
-                    pulse_sum_glob[i_gain, i_pix], length = varint(data, offset=pos)
-                    pos += length
+    with nogil:
+        for i in range(pixel_list_length):
+            i_pix = pixel_list[i]
+            if i_pix < 0:
+                status = STATUS_INDEX_OUT_OF_RANGE
+                break
 
-    if with_sum and len(pixel_list) > 0 and not glob_only_selected:
-        for i_gain in range(n_gains):
-            for i_pix in range(n_pixels):
-                pulse_sum_glob[i_gain, i_pix], length = varint(
-                    data, offset=pos,
-                )
-                pos += length
+            status = parse_pixel_timing(
+                ptr, size, &pos, i_pix, n_gains, n_pixels, n_types,
+                with_sum, glob_only_selected, granularity,
+                timval_ptr, loc_ptr, glob_ptr,
+            )
+            if status != STATUS_OK:
+                break
+
+        if status == STATUS_OK and with_sum and pixel_list_length > 0 and not glob_only_selected:
+            status = parse_global_pulse_sums(ptr, size, &pos, n_gains, n_pixels, glob_ptr)
+
+    check_status(status)
 
     return {
         'time': timval,
@@ -498,28 +827,101 @@ cpdef simtel_pixel_timing_parse_list_type_1(
     }, pos
 
 
+class CSRList(Sequence):
+    '''
+    Read-only list of arrays, stored as one flat array ``values``
+    and the ``offsets`` (length + 1) of the entries in it.
+
+    Entry ``i`` is the view ``values[offsets[i]:offsets[i + 1]]``,
+    which is only created when it is accessed.
+    '''
+    __slots__ = ('offsets', 'values')
+
+    def __init__(self, offsets, values):
+        self.offsets = offsets
+        self.values = values
+
+    def __len__(self):
+        return len(self.offsets) - 1
 
+    def __getitem__(self, index):
+        if isinstance(index, slice):
+            return [self[i] for i in range(*index.indices(len(self)))]
+
+        n = len(self)
+        if index < 0:
+            index += n
+        if not 0 <= index < n:
+            raise IndexError('CSRList index out of range')
+        return self.values[self.offsets[index]:self.offsets[index + 1]]
+
+    def __reduce__(self):
+        return CSRList, (self.offsets, self.values)
+
+    @property
+    def lengths(self):
+        '''Number of values of each entry'''
+        return np.diff(self.offsets)
+
+    def __repr__(self):
+        return '{}(n_entries={}, n_values={})'.format(
+            self.__class__.__name__, len(self), len(self.values)
+        )
+
+
+@cython.boundscheck(False)
 @cython.wraparound(False)  # disable negative indexing
 cpdef read_sector_information_v2(
-    const uint8_t[:] data,
+    const uint8_t[::1] data,
     uint32_t n_pixels,
     uint64_t offset = 0,
 ):
-    cdef uint32_t i
-    cdef uint64_t length
-    cdef int64_t n
-
-    cdef list sectors = []
-    cdef cnp.ndarray[int64_t, ndim=1] sector
-
+    '''Read the varint sector lists of all pixels of a CameraOrganization (version 2).
+
+    Returns
+    -------
+    sectors: CSRList
+        The sectors of each pixel, stored as ``offsets`` (n_pixels + 1)
+        into the flat int64 array ``values``
+    bytes_read: int
+    '''
+    cdef const uint8_t* ptr = buffer_pointer(data)
+    cdef uint64_t size = data.shape[0]
     cdef uint64_t pos = offset
-    for i in range(n_pixels):
-
-        n, length = varint(data, offset=pos)
-        pos += length
-
-        sector, length = varint_array(data, n, offset=pos)
-        pos += length
-        sectors.append(sector)
-
-    return sectors, pos - offset
+    cdef uint64_t i, j
+    cdef uint64_t n_values = 0
+    cdef int64_t n
+    cdef int status = STATUS_OK
+
+    # each varint needs at least one byte, so the flat array of
+    # all sector entries cannot be longer than the remaining data
+    cdef uint64_t capacity = size - offset if size > offset else 0
+    cdef cnp.npy_intp[1] shape = [capacity]
+    cdef cnp.ndarray[int64_t, ndim=1] values = cnp.PyArray_SimpleNew(1, shape, cnp.NPY_INT64)
+    shape[0] = n_pixels + 1
+    cdef cnp.ndarray[int64_t, ndim=1] offsets = cnp.PyArray_SimpleNew(1, shape, cnp.NPY_INT64)
+    cdef int64_t* values_ptr = <int64_t*> cnp.PyArray_DATA(values)
+    cdef int64_t* offsets_ptr = <int64_t*> cnp.PyArray_DATA(offsets)
+
+    with nogil:
+        offsets_ptr[0] = 0
+        for i in range(n_pixels):
+            status = read_varint(ptr, size, &pos, &n)
+            if status != STATUS_OK:
+                break
+            if n < 0 or n_values + n > capacity:
+                status = STATUS_BUFFER_OVERRUN
+                break
+
+            for j in range(<uint64_t> n):
+                status = read_varint(ptr, size, &pos, &values_ptr[n_values])
+                if status != STATUS_OK:
+                    break
+                n_values += 1
+
+            if status != STATUS_OK:
+                break
+            offsets_ptr[i + 1] = n_values
+
+    check_status(status)
+    return CSRList(offsets, values[:n_values].copy()), pos - offset
@@ -0,0 +1,273 @@
+# cython: language_level=3
+# Inline decoding kernels shared by the cython modules.
+#
+# All functions work on raw pointers, can be called without the GIL
+# and check all accesses against the size of the input buffer.
+# Instead of raising exceptions, they return a status code,
+# which is converted into an exception using `check_status` once the
+# GIL is held again.
+from libc.stdint cimport uint8_t, uint16_t, uint32_t, uint64_t, int16_t, int32_t, int64_t
+from libc.string cimport memcpy
+
+
+ctypedef fused sample_t:
+    uint16_t
+    uint32_t
+
+
+cdef enum:
+    STATUS_OK = 0
+    STATUS_BUFFER_OVERRUN = 1
+    STATUS_INDEX_OUT_OF_RANGE = 2
+
+
+cdef inline int check_status(int status) except -1:
+    if status == STATUS_BUFFER_OVERRUN:
+        raise IndexError('Trying to read beyond the end of the data')
+    if status == STATUS_INDEX_OUT_OF_RANGE:
+        raise IndexError('Index in data out of range of the output array')
+    return 0
+
+
+cdef inline const uint8_t* buffer_pointer(const uint8_t[::1] data):
+    # taking the address of the first element of an empty buffer is not allowed
+    if data.shape[0] == 0:
+        return NULL
+    return &data[0]
+
+
+cdef inline uint8_t varint_length(uint8_t first_byte) nogil:
+    if (first_byte & 0x80) == 0:
+        return 1
+    if (first_byte & 0xc0) == 0x80:
+        return 2
+    if (first_byte & 0xe0) == 0xc0:
+        return 3
+    if (first_byte & 0xf0) == 0xe0:
+        return 4
+    if (first_byte & 0xf8) == 0xf0:
+        return 5
+    if (first_byte & 0xfc) == 0xf8:
+        return 6
+    if (first_byte & 0xfe) == 0xfc:
+        return 7
+    if first_byte == 0xfe:
+        return 8
+    return 9
+
+
+cdef inline int read_unsigned_varint(
+    const uint8_t* data, uint64_t size, uint64_t* pos, uint64_t* value
+) nogil:
+    cdef uint64_t p = pos[0]
+    cdef uint8_t length, i
+    cdef uint64_t v
+
+    if p >= size:
+        return STATUS_BUFFER_OVERRUN
+
+    length = varint_length(data[p])
+    if p + length > size:
+        return STATUS_BUFFER_OVERRUN
+
+    # the length prefix takes the upper bits of the first byte,
+    # for 8 and 9 bytes, the first byte only holds the prefix
+    if length == 1:
+        v = data[p]
+    elif length < 8:
+        v = data[p] & (0xff >> length)
+    else:
+        v = 0
+
+    for i in range(1, length):
+        v = (v << 8) | data[p + i]
+
+    pos[0] = p + length
+    value[0] = v
+    return STATUS_OK
+
+
+cdef inline int read_varint(
+    const uint8_t* data, uint64_t size, uint64_t* pos, int64_t* value
+) nogil:
+    cdef uint64_t u
+    cdef int status = read_unsigned_varint(data, size, pos, &u)
+    if status != STATUS_OK:
+        return status
+
+    # zig-zag encoding of signed values
+    if (u & 1) == 1:
+        value[0] = -<int64_t>(u >> 1) - 1
+    else:
+        value[0] = <int64_t>(u >> 1)
+    return STATUS_OK
+
+
+cdef inline int read_int16(
+    const uint8_t* data, uint64_t size, uint64_t* pos, int16_t* value
+) nogil:
+    if pos[0] + 2 > size:
+        return STATUS_BUFFER_OVERRUN
+    memcpy(value, data + pos[0], 2)
+    pos[0] += 2
+    return STATUS_OK
+
+
+cdef inline int read_int32(
+    const uint8_t* data, uint64_t size, uint64_t* pos, int32_t* value
+) nogil:
+    if pos[0] + 4 > size:
+        return STATUS_BUFFER_OVERRUN
+    memcpy(value, data + pos[0], 4)
+    pos[0] += 4
+    return STATUS_OK
+
+
+cdef inline int read_float(
+    const uint8_t* data, uint64_t size, uint64_t* pos, float* value
+) nogil:
+    if pos[0] + 4 > size:
+        return STATUS_BUFFER_OVERRUN
+    memcpy(value, data + pos[0], 4)
+    pos[0] += 4
+    return STATUS_OK
+
+
+cdef extern from "varint_simd.h" nogil:
+    # name of the instruction set used by the vectorized decoder
+    const char* EVENTIO_VARINT_SIMD
+    size_t eventio_delta_run_u16(const uint8_t* data, size_t n, int32_t* acc, uint16_t* out)
+    size_t eventio_delta_run_u32(const uint8_t* data, size_t n, int32_t* acc, uint32_t* out)
+
+
+cdef inline int read_varint_delta(
+    const uint8_t* data, uint64_t size, uint64_t* pos, int32_t* delta
+) nogil:
+    # Read one signed varint of at most 5 bytes as used in the
+    # differential encoding.
+    cdef uint64_t p = pos[0]
+    cdef uint8_t v0, v1, v2, v3, v4
+    cdef uint32_t u
+
+    if p >= size:
+        return STATUS_BUFFER_OVERRUN
+    v0 = data[p]
+
+    if (v0 & 0x80) == 0:  # one byte
+        p += 1
+        u = v0 >> 1
+    elif (v0 & 0xc0) == 0x80:  # two bytes
+        if p + 2 > size:
+            return STATUS_BUFFER_OVERRUN
+        v1 = data[p + 1]
+        p += 2
+        u = ((v0 & 0x3f) << 7) | (v1 >> 1)
+        v0 = v1
+    elif (v0 & 0xe0) == 0xc0:  # three bytes
+        if p + 3 > size:
+            return STATUS_BUFFER_OVERRUN
+        v1 = data[p + 1]
+        v2 = data[p + 2]
+        p += 3
+        u = ((v0 & 0x1f) << 15) | (v1 << 7) | (v2 >> 1)
+        v0 = v2
+    elif (v0 & 0xf0) == 0xe0:  # four bytes
+        if p + 4 > size:
+            return STATUS_BUFFER_OVERRUN
+        v1 = data[p + 1]
+        v2 = data[p + 2]
+        v3 = data[p + 3]
+        p += 4
+        u = ((v0 & 0x0f) << 23) | (v1 << 15) | (v2 << 7) | (v3 >> 1)
+        v0 = v3
+    else:
+        if p + 5 > size:
+            return STATUS_BUFFER_OVERRUN
+        v1 = data[p + 1]
+        v2 = data[p + 2]
+        v3 = data[p + 3]
+        v4 = data[p + 4]
+        p += 5
+        # The format would allow bits 32 and 33 being set but we ignore this here.
+        u = (
+            ((<uint32_t> v0 & 0x07) << 31)
+            | (<uint32_t> v1 << 23)
+            | (<uint32_t> v2 << 15)
+            | (<uint32_t> v3 << 7)
+            | (v4 >> 1)
+        )
+        v0 = v4
+
+    # v0 now is the last byte, its lowest bit is the sign
+    if (v0 & 0x01) == 0:
+        delta[0] = <int32_t> u
+    else:
+        delta[0] = -<int32_t> u - 1
+
+    pos[0] = p
+    return STATUS_OK
+
+
+cdef inline int decode_unsigned_varint_differential_scalar(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    sample_t* output,
+    uint64_t n_elements,
+) nogil:
+    # Reference implementation of `decode_unsigned_varint_differential`,
+    # decoding one element at a time.
+    cdef int32_t val = 0
+    cdef int32_t delta
+    cdef uint64_t i
+    cdef int status
+
+    for i in range(n_elements):
+        status = read_varint_delta(data, size, pos, &delta)
+        if status != STATUS_OK:
+            return status
+        val += delta
+        output[i] = <sample_t> val
+
+    return STATUS_OK
+
+
+cdef inline int decode_unsigned_varint_differential(
+    const uint8_t* data,
+    uint64_t size,
+    uint64_t* pos,
+    sample_t* output,
+    uint64_t n_elements,
+) nogil:
+    # Decode n_elements differentially encoded, signed varints
+    # (at most 5 bytes each) into output.
+    # For uint16_t output, values are truncated like numpy's astype.
+    # Runs of single byte varints, by far the most common case,
+    # are decoded using SIMD instructions, see varint_simd.h
+    cdef int32_t val = 0
+    cdef int32_t delta
+    cdef uint64_t i = 0
+    cdef uint64_t p = pos[0]
+    cdef uint64_t n
+    cdef int status
+
+    while i < n_elements:
+        if p < size and data[p] < 0x80:
+            n = min(size - p, n_elements - i)
+            if sample_t is uint16_t:
+                n = eventio_delta_run_u16(data + p, n, &val, output + i)
+            else:
+                n = eventio_delta_run_u32(data + p, n, &val, output + i)
+            p += n
+            i += n
+            continue
+
+        status = read_varint_delta(data, size, &p, &delta)
+        if status != STATUS_OK:
+            return status
+        val += delta
+        output[i] = <sample_t> val
+        i += 1
+
+    pos[0] = p
+    return STATUS_OK
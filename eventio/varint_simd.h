@@ -0,0 +1,193 @@
+/*
+ * Vectorized decoding of runs of single byte, differentially encoded varints.
+ *
+ * In the differential encoding used for ADC sums and samples, every element
+ * is stored as the zig-zag encoded difference to the previous element.
+ * Almost all of these differences fit into a single byte, which is the case
+ * if the highest bit of the byte is not set. Sixteen such bytes are decoded
+ * at once using a prefix sum; the caller handles multi byte varints with
+ * the scalar code in var_int_kernels.pxd, which is also the reference
+ * implementation.
+ *
+ * SSE2 is part of the x86-64 baseline and NEON of AArch64, so no runtime
+ * dispatch is needed. Define EVENTIO_NO_SIMD to use the scalar code only.
+ */
+#ifndef EVENTIO_VARINT_SIMD_H
+#define EVENTIO_VARINT_SIMD_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#if !defined(EVENTIO_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#define EVENTIO_VARINT_SSE2 1
+#define EVENTIO_VARINT_SIMD "sse2"
+#include <emmintrin.h>
+#elif !defined(EVENTIO_NO_SIMD) && defined(__aarch64__) && defined(__ARM_NEON)
+#define EVENTIO_VARINT_NEON 1
+#define EVENTIO_VARINT_SIMD "neon"
+#include <arm_neon.h>
+#else
+#define EVENTIO_VARINT_SIMD "none"
+#endif
+
+static inline int32_t eventio_zigzag_byte(uint8_t b) {
+    return (b & 1) ? -(int32_t) (b >> 1) - 1 : (int32_t) (b >> 1);
+}
+
+#if defined(EVENTIO_VARINT_SSE2)
+
+typedef __m128i eventio_vector_t;
+
+static inline __m128i eventio_prefix_sum_epi16(__m128i x) {
+    x = _mm_add_epi16(x, _mm_slli_si128(x, 2));
+    x = _mm_add_epi16(x, _mm_slli_si128(x, 4));
+    x = _mm_add_epi16(x, _mm_slli_si128(x, 8));
+    return x;
+}
+
+/* Zig-zag decode 16 single byte varints and compute the prefix sums of the
+ * two halves as int16, which cannot overflow for at most 8 values in [-64, 63]. */
+static inline void eventio_decode_block(const uint8_t* data, __m128i* lo, __m128i* hi) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i b = _mm_loadu_si128((const __m128i*) data);
+    __m128i half = _mm_and_si128(_mm_srli_epi16(b, 1), _mm_set1_epi8(0x7f));
+    __m128i sign = _mm_sub_epi8(zero, _mm_and_si128(b, _mm_set1_epi8(1)));
+    __m128i delta = _mm_xor_si128(half, sign);
+    __m128i extension = _mm_cmpgt_epi8(zero, delta);
+    *lo = eventio_prefix_sum_epi16(_mm_unpacklo_epi8(delta, extension));
+    *hi = eventio_prefix_sum_epi16(_mm_unpackhi_epi8(delta, extension));
+}
+
+static inline int eventio_block_is_single_byte(const uint8_t* data) {
+    return _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) data)) == 0;
+}
+
+static inline int32_t eventio_last_epi16(__m128i x) {
+    return (int16_t) _mm_extract_epi16(x, 7);
+}
+
+static inline void eventio_store_u16(uint16_t* out, __m128i lo, __m128i hi, int32_t acc) {
+    const __m128i base = _mm_set1_epi16((int16_t) acc);
+    const __m128i base_hi = _mm_set1_epi16((int16_t) (acc + eventio_last_epi16(lo)));
+    _mm_storeu_si128((__m128i*) out, _mm_add_epi16(lo, base));
+    _mm_storeu_si128((__m128i*) (out + 8), _mm_add_epi16(hi, base_hi));
+}
+
+static inline void eventio_store_u32(uint32_t* out, __m128i lo, __m128i hi, int32_t acc) {
+    const __m128i base = _mm_set1_epi32(acc);
+    const __m128i base_hi = _mm_set1_epi32(acc + eventio_last_epi16(lo));
+    __m128i lo_sign = _mm_srai_epi16(lo, 15);
+    __m128i hi_sign = _mm_srai_epi16(hi, 15);
+    _mm_storeu_si128((__m128i*) out, _mm_add_epi32(_mm_unpacklo_epi16(lo, lo_sign), base));
+    _mm_storeu_si128((__m128i*) (out + 4), _mm_add_epi32(_mm_unpackhi_epi16(lo, lo_sign), base));
+    _mm_storeu_si128((__m128i*) (out + 8), _mm_add_epi32(_mm_unpacklo_epi16(hi, hi_sign), base_hi));
+    _mm_storeu_si128((__m128i*) (out + 12), _mm_add_epi32(_mm_unpackhi_epi16(hi, hi_sign), base_hi));
+}
+
+#elif defined(EVENTIO_VARINT_NEON)
+
+typedef int16x8_t eventio_vector_t;
+
+static inline int16x8_t eventio_prefix_sum_s16(int16x8_t x) {
+    const int16x8_t zero = vdupq_n_s16(0);
+    x = vaddq_s16(x, vextq_s16(zero, x, 7));
+    x = vaddq_s16(x, vextq_s16(zero, x, 6));
+    x = vaddq_s16(x, vextq_s16(zero, x, 4));
+    return x;
+}
+
+static inline void eventio_decode_block(const uint8_t* data, int16x8_t* lo, int16x8_t* hi) {
+    uint8x16_t b = vld1q_u8(data);
+    int8x16_t half = vreinterpretq_s8_u8(vshrq_n_u8(b, 1));
+    int8x16_t sign = vnegq_s8(vreinterpretq_s8_u8(vandq_u8(b, vdupq_n_u8(1))));
+    int8x16_t delta = veorq_s8(half, sign);
+    *lo = eventio_prefix_sum_s16(vmovl_s8(vget_low_s8(delta)));
+    *hi = eventio_prefix_sum_s16(vmovl_s8(vget_high_s8(delta)));
+}
+
+static inline int eventio_block_is_single_byte(const uint8_t* data) {
+    return vmaxvq_u8(vld1q_u8(data)) < 0x80;
+}
+
+static inline int32_t eventio_last_epi16(int16x8_t x) {
+    return vgetq_lane_s16(x, 7);
+}
+
+static inline void eventio_store_u16(uint16_t* out, int16x8_t lo, int16x8_t hi, int32_t acc) {
+    const int16x8_t base = vdupq_n_s16((int16_t) acc);
+    const int16x8_t base_hi = vdupq_n_s16((int16_t) (acc + eventio_last_epi16(lo)));
+    vst1q_u16(out, vreinterpretq_u16_s16(vaddq_s16(lo, base)));
+    vst1q_u16(out + 8, vreinterpretq_u16_s16(vaddq_s16(hi, base_hi)));
+}
+
+static inline void eventio_store_u32(uint32_t* out, int16x8_t lo, int16x8_t hi, int32_t acc) {
+    const int32x4_t base = vdupq_n_s32(acc);
+    const int32x4_t base_hi = vdupq_n_s32(acc + eventio_last_epi16(lo));
+    vst1q_u32(out, vreinterpretq_u32_s32(vaddq_s32(vmovl_s16(vget_low_s16(lo)), base)));
+    vst1q_u32(out + 4, vreinterpretq_u32_s32(vaddq_s32(vmovl_s16(vget_high_s16(lo)), base)));
+    vst1q_u32(out + 8, vreinterpretq_u32_s32(vaddq_s32(vmovl_s16(vget_low_s16(hi)), base_hi)));
+    vst1q_u32(out + 12, vreinterpretq_u32_s32(vaddq_s32(vmovl_s16(vget_high_s16(hi)), base_hi)));
+}
+
+#endif
+
+/*
+ * Decode the run of single byte varints at the start of data,
+ * reading at most n bytes and writing at most n values to out.
+ * *acc holds the last decoded value and is updated.
+ * Returns the number of decoded values, decoding stops at the first
+ * byte starting a multi byte varint.
+ */
+static inline size_t eventio_delta_run_u16(
+    const uint8_t* data, size_t n, int32_t* acc, uint16_t* out
+) {
+    size_t i = 0;
+    int32_t val = *acc;
+
+#if defined(EVENTIO_VARINT_SSE2) || defined(EVENTIO_VARINT_NEON)
+    while (i + 16 <= n && eventio_block_is_single_byte(data + i)) {
+        eventio_vector_t lo, hi;
+        eventio_decode_block(data + i, &lo, &hi);
+        eventio_store_u16(out + i, lo, hi, val);
+        val += eventio_last_epi16(lo) + eventio_last_epi16(hi);
+        i += 16;
+    }
+#endif
+
+    while (i < n && data[i] < 0x80) {
+        val += eventio_zigzag_byte(data[i]);
+        out[i] = (uint16_t) val;
+        i++;
+    }
+
+    *acc = val;
+    return i;
+}
+
+static inline size_t eventio_delta_run_u32(
+    const uint8_t* data, size_t n, int32_t* acc, uint32_t* out
+) {
+    size_t i = 0;
+    int32_t val = *acc;
+
+#if defined(EVENTIO_VARINT_SSE2) || defined(EVENTIO_VARINT_NEON)
+    while (i + 16 <= n && eventio_block_is_single_byte(data + i)) {
+        eventio_vector_t lo, hi;
+        eventio_decode_block(data + i, &lo, &hi);
+        eventio_store_u32(out + i, lo, hi, val);
+        val += eventio_last_epi16(lo) + eventio_last_epi16(hi);
+        i += 16;
+    }
+#endif
+
+    while (i < n && data[i] < 0x80) {
+        val += eventio_zigzag_byte(data[i]);
+        out[i] = (uint32_t) val;
+        i++;
+    }
+
+    *acc = val;
+    return i;
+}
+
+#endif /* EVENTIO_VARINT_SIMD_H */
@@ -0,0 +1,339 @@
+'''
+Writing of eventio files.
+
+`EventIOWriter` writes toplevel objects either uncompressed or into
+a zstd file in the seekable format: each zstd frame only contains complete
+toplevel objects and a seek table with the sizes of all frames is appended
+to the file.
+Such files can be decompressed on several threads
+(see `EventIOFile(decompression_threads=...)`) and allow fast random access
+(see `EventIOFile(seekable=True)`), while still being readable by
+all zstd tools.
+
+`repack` rewrites an existing file this way, optionally keeping only some
+object types or telescopes.
+'''
+from collections import deque
+from concurrent.futures import ThreadPoolExecutor
+import struct
+
+from .base import EventIOFile
+from . import constants
+from .iact import TelescopeData, Photons, PhotoElectrons
+from .compression import (
+    ZSTD_SEEK_TABLE_MAGIC,
+    ZSTD_SEEKABLE_MAGIC,
+    ZSTD_SEEK_TABLE_FOOTER,
+)
+
+try:
+    import zstandard as zstd
+    has_zstd = True
+except ImportError:
+    has_zstd = False
+
+
+DEFAULT_FRAME_SIZE = 4 * 1024**2
+
+LENGTH_MASK = 2**constants.LENGTH_NUM_BITS - 1
+MAX_CONTENT_SIZE = 2**(constants.LENGTH_NUM_BITS + constants.EXTENSION_NUM_BITS) - 1
+
+
+def encode_header(header, content_size=None, toplevel=True):
+    '''Encode the header of an eventio object.
+
+    Parameters
+    ----------
+    header: ObjectHeader
+        type, version, id and flags of the object are taken from this header
+    content_size: int or None
+        Size of the payload, if None, `header.content_size` is used.
+        The extension field is added if the size does not fit
+        into the length field.
+    toplevel: bool
+        If True, the sync marker is prepended
+
+    Returns
+    -------
+    header_bytes: bytes
+    '''
+    if content_size is None:
+        content_size = header.content_size
+
+    if content_size > MAX_CONTENT_SIZE:
+        raise ValueError('Object too large for eventio: {} bytes'.format(content_size))
+
+    extension = content_size >> constants.LENGTH_NUM_BITS
+    extended = bool(header.extended or extension > 0)
+
+    type_field = (
+        (header.type << constants.TYPE_POS)
+        | (int(header.user) << constants.USER_POS)
+        | (int(extended) << constants.EXTENDED_POS)
+        | (header.version << constants.VERSION_POS)
+    )
+    length_field = (
+        ((content_size & LENGTH_MASK) << constants.LENGTH_POS)
+        | (int(header.only_subobjects) << constants.ONLY_SUBOBJECTS_POS)
+    )
+
+    data = struct.pack('<III', type_field, header.id, length_field)
+    if extended:
+        data += struct.pack('<I', extension << constants.EXTENSION_POS)
+
+    if toplevel:
+        data = constants.SYNC_MARKER_LITTLE_ENDIAN + data
+
+    return data
+
+
+def read_payload(obj):
+    obj.seek(0)
+    return obj.read()
+
+
+def filter_telescopes(obj, telescopes):
+    '''Payload of `obj` without the data of telescopes not in `telescopes`.
+
+    Subobjects with a `telescope_id` not in `telescopes` are removed,
+    all other containers are searched recursively and re-encoded with
+    their new size.
+    The photons and photo electrons in a `TelescopeData` block are stored
+    by telescope index, which is the telescope id - 1, as in `SimTelFile`.
+    Summary objects like the central trigger information are not modified.
+
+    Parameters
+    ----------
+    obj: EventIOObject
+        The object to filter
+    telescopes: set[int]
+        The telescope ids to keep
+
+    Returns
+    -------
+    payload: bytes
+    '''
+    if not obj.only_subobjects:
+        return read_payload(obj)
+
+    obj.seek(0)
+    parts = []
+    for subobject in obj:
+        telescope_id = getattr(subobject, 'telescope_id', None)
+        if (
+            telescope_id is not None
+            and isinstance(obj, TelescopeData)
+            and isinstance(subobject, (Photons, PhotoElectrons))
+        ):
+            telescope_id += 1
+
+        if telescope_id is not None and telescope_id not in telescopes:
+            continue
+
+        if telescope_id is None and subobject.only_subobjects:
+            payload = filter_telescopes(subobject, telescopes)
+        else:
+            payload = read_payload(subobject)
+
+        parts.append(encode_header(subobject.header, len(payload), toplevel=False))
+        parts.append(payload)
+
+    return b''.join(parts)
+
+
+def _compress_frame(data, level):
+    # compressors can not be shared between threads
+    return zstd.ZstdCompressor(level=level).compress(data), len(data)
+
+
+class EventIOWriter:
+    '''
+    Write toplevel eventio objects to a new file.
+
+    Objects are collected into frames of at least `frame_size` bytes,
+    objects are never split between two frames.
+    For zstd compression, each frame is compressed independently
+    and a seek table is written when the file is closed.
+
+    Parameters
+    ----------
+    path: str
+        Path of the output file
+    compress: bool or None
+        Write a zstd compressed file. If None (default),
+        compress if `path` ends with ".zst"
+    level: int
+        zstd compression level
+    frame_size: int
+        Minimum uncompressed size of a frame in bytes,
+        only the last frame can be smaller.
+    n_threads: int
+        Number of threads used for compression
+    '''
+    def __init__(
+        self,
+        path,
+        compress=None,
+        level=3,
+        frame_size=DEFAULT_FRAME_SIZE,
+        n_threads=1,
+    ):
+        if compress is None:
+            compress = str(path).endswith('.zst')
+
+        if compress and not has_zstd:
+            raise IOError(
+                'You need to install the `zstandard` module '
+                'to write zstd compressed files'
+            )
+
+        self.path = path
+        self.compress = compress
+        self.level = level
+        self.frame_size = frame_size
+        self.n_threads = n_threads
+        # (compressed size, uncompressed size) of all written frames
+        self.frames = []
+        self.closed = False
+
+        self._file = open(path, 'wb')
+        self._buffer = []
+        self._buffer_size = 0
+        self._pending = deque()
+        self._executor = None
+        if compress and n_threads > 1:
+            self._executor = ThreadPoolExecutor(max_workers=n_threads)
+
+    def write(self, header, payload):
+        '''Write a toplevel object with the type, version, id and flags of
+        `header` and the given payload.
+
+        Parameters
+        ----------
+        header: ObjectHeader
+            Header of the object, its content size is ignored
+        payload: bytes-like
+            The complete payload of the object
+        '''
+        if self.closed:
+            raise ValueError('I/O operation on closed writer')
+
+        self._buffer.append(encode_header(header, len(payload), toplevel=True))
+        self._buffer.append(payload)
+        self._buffer_size += len(self._buffer[-2]) + len(payload)
+
+        if self._buffer_size >= self.frame_size:
+            self._finish_frame()
+
+    def write_object(self, obj):
+        '''Write a copy of the toplevel `EventIOObject` `obj`'''
+        self.write(obj.header, read_payload(obj))
+
+    def _finish_frame(self):
+        if self._buffer_size == 0:
+            return
+
+        data = b''.join(self._buffer)
+        self._buffer = []
+        self._buffer_size = 0
+
+        if not self.compress:
+            self._file.write(data)
+            self.frames.append((len(data), len(data)))
+        elif self._executor is None:
+            self._write_frame(*_compress_frame(data, self.level))
+        else:
+            self._pending.append(
+                self._executor.submit(_compress_frame, data, self.level)
+            )
+            # frames have to be written in order, limit the queued frames
+            # so memory usage stays bounded
+            while len(self._pending) > 2 * self.n_threads:
+                self._write_frame(*self._pending.popleft().result())
+
+    def _write_frame(self, compressed, uncompressed_size):
+        self._file.write(compressed)
+        self.frames.append((len(compressed), uncompressed_size))
+
+    def _write_seek_table(self):
+        entries = b''.join(
+            struct.pack('<II', compressed_size, uncompressed_size)
+            for compressed_size, uncompressed_size in self.frames
+        )
+        footer = ZSTD_SEEK_TABLE_FOOTER.pack(len(self.frames), 0, ZSTD_SEEKABLE_MAGIC)
+        self._file.write(struct.pack(
+            '<II', ZSTD_SEEK_TABLE_MAGIC, len(entries) + len(footer)
+        ))
+        self._file.write(entries)
+        self._file.write(footer)
+
+    def close(self):
+        if self.closed:
+            return
+
+        try:
+            self._finish_frame()
+            while self._pending:
+                self._write_frame(*self._pending.popleft().result())
+            if self.compress:
+                self._write_seek_table()
+        finally:
+            if self._executor is not None:
+                self._executor.shutdown(wait=True)
+            self._file.close()
+            self.closed = True
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+
+def repack(input_path, output_path, types=None, telescopes=None, **kwargs):
+    '''Rewrite the eventio file at `input_path` using `EventIOWriter`.
+
+    Parameters
+    ----------
+    input_path: str
+        The file to read
+    output_path: str
+        The file to write
+    types: iterable[int] or None
+        If given, only toplevel objects of these types are written
+    telescopes: iterable[int] or None
+        If given, the data of other telescopes is removed from all
+        toplevel containers, see `filter_telescopes`.
+        Toplevel objects of a single telescope, like the telescope descriptions
+        at the beginning of a simtel file, are kept, so that readers find
+        the descriptions of all telescopes of the run.
+    **kwargs:
+        Passed to `EventIOWriter`
+
+    Returns
+    -------
+    n_objects: int
+        Number of written toplevel objects
+    '''
+    if types is not None:
+        types = set(types)
+    if telescopes is not None:
+        telescopes = set(telescopes)
+
+    n_objects = 0
+    with EventIOFile(input_path) as f, EventIOWriter(output_path, **kwargs) as writer:
+        for obj in f:
+            if types is not None and obj.header.type not in types:
+                continue
+
+            if (
+                telescopes is not None
+                and obj.only_subobjects
+                and getattr(obj, 'telescope_id', None) is None
+            ):
+                writer.write(obj.header, filter_telescopes(obj, telescopes))
+            else:
+                writer.write_object(obj)
+            n_objects += 1
+
+    return n_objects
@@ -9,6 +9,10 @@ parser.add_argument('inputfile')
 parser.add_argument('-s', '--sort', default='cumtime')
 parser.add_argument('-l', '--limit', default=50, type=int)
 parser.add_argument('-t', '--telescopes')
+parser.add_argument(
+    '-i', '--instrumentation', action='store_true',
+    help='Print time and bytes per object type instead of running cProfile',
+)
 args = parser.parse_args()
 
 
@@ -18,6 +22,27 @@ if args.telescopes:
 else:
     allowed_telescopes = None
 
+if args.instrumentation:
+    with SimTelFile(
+        args.inputfile, allowed_telescopes=allowed_telescopes, instrumentation=True
+    ) as f:
+        for e in f:
+            pass
+
+    stats = f.instrumentation.as_dict()
+    print('{:>6} {:>3} {:<26} {:>9} {:>12} {:>9} {:>9}'.format(
+        'type', 'v', 'name', 'objects', 'MB', 'parse/s', 'io/s'
+    ))
+    for (type_, version, variant), s in sorted(
+        stats.items(), key=lambda item: item[1]['parse_seconds'], reverse=True
+    ):
+        name = s['name'] if variant is None else '{} ({})'.format(s['name'], variant)
+        print('{:>6} {:>3} {:<26} {:>9} {:>12.2f} {:>9.3f} {:>9.3f}'.format(
+            type_, version, name, s['n_objects'], s['n_bytes'] / 1024**2,
+            s['parse_seconds'], s['io_seconds'],
+        ))
+    raise SystemExit
+
 pr = cProfile.Profile()
 pr.enable()
 
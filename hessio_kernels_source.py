@@ -0,0 +1,65 @@
+'''
+Extract the self-contained varint functions of the vendored hessioxxx
+library, used to build the optional `eventio.simtel.hessio` extension
+(see setup.py) and the reference kernels of the benchmarks.
+
+The functions are copied verbatim from hessioxxx-20181107/eventio.c,
+the rest of the library is not part of this repository and replaced
+by a minimal `IO_BUFFER`.
+This module must only use the standard library, setup.py imports it
+before anything is built.
+'''
+import os
+
+
+eventio_c = os.path.join(os.path.dirname(os.path.abspath(__file__)), 'hessioxxx-20181107', 'eventio.c')
+
+functions = (
+    'uintmax_t get_count (IO_BUFFER *iobuf)',
+    'uint32_t get_count32 (IO_BUFFER *iobuf)',
+    'intmax_t get_scount (IO_BUFFER *iobuf)',
+    'int32_t get_scount32 (IO_BUFFER *iobuf)',
+    'void get_vector_of_uint16_scount_differential (uint16_t *vec, int num, IO_BUFFER *iobuf)',
+    'void get_vector_of_uint32_scount_differential (uint32_t *vec, int num, IO_BUFFER *iobuf)',
+)
+
+# The Warning macro refers to the buffer by name, so this only works
+# because all extracted functions call their IO_BUFFER parameter `iobuf`.
+prelude = r'''
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned char BYTE;
+typedef struct {
+    BYTE *data;
+    long r_remaining;
+} IO_BUFFER;
+
+#define HAVE_64BIT_INT 1
+#define get_byte(iobuf) ((iobuf)->r_remaining-- > 0 ? (int) *(iobuf)->data++ : -1)
+/* invalid data marks the buffer as exhausted */
+#define Warning(msg) ((iobuf)->r_remaining = -1)
+'''
+
+
+def extract_function(source, signature):
+    start = source.index(signature)
+    end = source.index('\n}\n', start) + 3
+    return source[start:end]
+
+
+def kernel_source():
+    '''C code of the prelude and all extracted functions'''
+    with open(eventio_c, encoding='latin-1') as f:
+        source = f.read()
+
+    return '\n'.join([prelude] + [
+        extract_function(source, signature) for signature in functions
+    ])
+
+
+def write_header(directory):
+    '''Write the kernels as `hessio_kernels.h` into `directory`'''
+    os.makedirs(directory, exist_ok=True)
+    with open(os.path.join(directory, 'hessio_kernels.h'), 'w') as f:
+        f.write(kernel_source())
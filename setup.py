@@ -1,6 +1,7 @@
 from setuptools import setup, find_packages
 import os
 import re
+import sys
 
 # make sure users without cython can install our extensions
 try:
@@ -28,12 +29,40 @@ class build_ext(_build_ext):
 ext = '.pyx' if USE_CYTHON else '.c'
 extensions = [
     Extension('eventio.header', sources=['eventio/header' + ext]),
-    Extension('eventio.var_int', sources=['eventio/var_int' + ext]),
+    Extension(
+        'eventio.var_int',
+        sources=['eventio/var_int' + ext],
+        include_dirs=['eventio'],
+    ),
     Extension(
         'eventio.simtel.parsing',
-        sources=['eventio/simtel/parsing' + ext]
+        sources=['eventio/simtel/parsing' + ext],
+        include_dirs=['eventio'],
+    ),
+    Extension(
+        'eventio.iact.parsing',
+        sources=['eventio/iact/parsing' + ext]
     ),
 ]
+
+
+# optional decoders using the IO_BUFFER routines of the vendored hessioxxx
+# library, see `SimTelFile(engine='hessio')`. Only the self-contained
+# varint functions of eventio.c are compiled, see hessio_kernels_source.py.
+# Its Warning macro marks the buffer as exhausted and relies on the extracted
+# functions naming their IO_BUFFER parameter `iobuf`.
+if os.environ.get('EVENTIO_BUILD_HESSIO'):
+    if not USE_CYTHON:
+        raise ImportError('You need `Cython` to build the hessio extension')
+    sys.path.insert(0, os.path.dirname(os.path.abspath(__file__)))
+    import hessio_kernels_source
+    hessio_kernels_source.write_header('build/hessio')
+    extensions.append(Extension(
+        'eventio.simtel.hessio',
+        sources=['eventio/simtel/hessio.pyx'],
+        include_dirs=['eventio', 'build/hessio'],
+    ))
+
 cmdclass = {'build_ext': build_ext}
 
 # give a nice error message if people cloned the
@@ -59,8 +88,9 @@ setup(
     cmdclass=cmdclass,
 
     package_data={
-        'eventio': ['*.c'],
+        'eventio': ['*.c', '*.h', '*.pxd'],
         'eventio.simtel': ['*.c'],
+        'eventio.iact': ['*.c'],
     },
     python_requires='>=3.5',
     install_requires=[
@@ -74,6 +104,8 @@ setup(
             'eventio_plot_histograms = eventio.scripts.plot_hists:main',
             'eventio_print_object_information = eventio.scripts.print_object_information:main',
             'eventio_cut_file = eventio.scripts.cut_eventio_file:main',
+            'eventio_repack_file = eventio.scripts.repack_eventio_file:main',
+            'eventio_export_simtel_file = eventio.scripts.export_simtel_file:main',
         ]
     },
     setup_requires=['pytest-runner', 'numpy'],
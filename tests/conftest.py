@@ -0,0 +1,6 @@
+'''
+Shared configuration of the tests.
+
+Having a conftest.py here puts this directory on sys.path,
+so test modules in all subdirectories can import `helpers`.
+'''
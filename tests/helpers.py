@@ -0,0 +1,51 @@
+'''
+Helpers shared by several test modules.
+'''
+import numpy as np
+from eventio import EventIOFile
+
+
+def object_contents(objects):
+    '''List of (type, payload) of the given eventio objects'''
+    return [(o.header.type, o.read()) for o in objects]
+
+
+def read_objects(path, **kwargs):
+    '''List of (type, payload) of all toplevel objects of the file at `path`,
+    kwargs are passed to `EventIOFile`'''
+    with EventIOFile(path, **kwargs) as f:
+        return object_contents(f)
+
+
+def assert_simtel_events_equal(events, expected):
+    '''Assert two lists of `SimTelFile` events contain the same data'''
+    assert len(events) == len(expected)
+
+    for event, expected_event in zip(events, expected):
+        assert event['type'] == expected_event['type']
+        assert event.get('event_id') == expected_event.get('event_id')
+        if 'mc_shower' in expected_event:
+            assert event['mc_shower']['shower'] == expected_event['mc_shower']['shower']
+        if 'camera_monitorings' in expected_event:
+            assert event['camera_monitorings'].keys() == expected_event['camera_monitorings'].keys()
+
+        assert event['telescope_events'].keys() == expected_event['telescope_events'].keys()
+        for tel_id, telescope_event in event['telescope_events'].items():
+            expected_telescope_event = expected_event['telescope_events'][tel_id]
+            if 'adc_samples' in expected_telescope_event:
+                assert np.array_equal(
+                    telescope_event['adc_samples'],
+                    expected_telescope_event['adc_samples'],
+                )
+
+
+def assert_iact_events_equal(events, expected):
+    '''Assert two lists of `IACTFile` events contain the same data'''
+    assert len(events) == len(expected)
+
+    for event, expected_event in zip(events, expected):
+        assert event.event_number == expected_event.event_number
+        assert event.reuse == expected_event.reuse
+        assert event.photon_bunches.keys() == expected_event.photon_bunches.keys()
+        for tel_id, bunches in event.photon_bunches.items():
+            assert np.array_equal(bunches, expected_event.photon_bunches[tel_id])
@@ -2,6 +2,8 @@ import eventio
 
 from pytest import approx, raises, importorskip
 
+from helpers import assert_iact_events_equal
+
 
 testfile = 'tests/resources/one_shower.dat'
 testfile_reuse = 'tests/resources/3_gammas_reuse_5.dat'
@@ -135,3 +137,44 @@ def test_event_with_reuse():
         for i, e in enumerate(f):
             assert e.event_number == i // 5 + 1
             assert e.reuse == (i % 5) + 1
+
+
+def test_iter_chunks():
+    import numpy as np
+
+    with eventio.IACTFile(testfile_two_telescopes) as f:
+        expected = [
+            (e.event_number, e.reuse, tel_id, bunches)
+            for e in f
+            for tel_id, bunches in e.photon_bunches.items()
+        ]
+
+    with eventio.IACTFile(testfile_two_telescopes) as f:
+        chunks = [
+            (c.event.event_number, c.event.reuse, c.telescope_id, c.bunches.copy())
+            for c in f.iter_chunks(chunk_size=100)
+        ]
+
+    assert all(len(c[3]) <= 100 for c in chunks)
+
+    for event_number, reuse, tel_id, bunches in expected:
+        parts = [
+            c[3] for c in chunks
+            if c[:3] == (event_number, reuse, tel_id)
+        ]
+        result = np.concatenate(parts) if parts else bunches[:0]
+        # parse separates emitter bunches, which cannot be in this file
+        assert len(result) == len(bunches)
+        for col in bunches.dtype.names:
+            assert np.allclose(result[col], bunches[col])
+
+
+def test_parallel_decoding():
+    with eventio.IACTFile(testfile_reuse) as f:
+        expected = list(f)
+
+    with eventio.IACTFile(testfile_reuse, n_workers=2) as f:
+        events = list(f)
+        assert f.run_end is not None
+
+    assert_iact_events_equal(events, expected)
@@ -27,6 +27,12 @@ def test_photo_electrons():
             assert len(data['pixel_id']) == data['n_pe']
             assert len(data['time']) == data['n_pe']
 
+            # photo electrons are grouped by pixel
+            offsets = data['pixel_offsets']
+            assert len(offsets) == data['n_pixels'] + 1
+            assert np.all(np.diff(offsets) == data['photoelectrons'])
+            assert np.all(np.diff(data['pixel_id'].astype(np.int64)) >= 0)
+
             # times should be within 200 nanoseconds
             assert np.all(0 <= data['time'])
             assert np.all(data['time'] <= 200)
@@ -35,6 +41,38 @@ def test_photo_electrons():
             assert len(not_read) == 0 or all(b == 0 for b in not_read)
 
 
+def test_photo_electrons_merged():
+    from eventio import EventIOFile
+    from eventio.iact import PhotoElectrons, TelescopeData
+    from eventio.search_utils import yield_toplevel_of_type
+
+    # the gzip module allows seeking back to parse the objects twice
+    with EventIOFile(prod4_simtel, zcat=False) as f:
+        telescope_data = next(yield_toplevel_of_type(f, TelescopeData))
+        objects = [o for o in telescope_data if isinstance(o, PhotoElectrons)]
+        expected = [o.parse() for o in objects]
+        merged = PhotoElectrons.parse_merged(objects)
+
+    assert len(merged['n_pe']) == len(expected)
+    pixel_offsets = merged['telescope_pixel_offsets']
+    pe_offsets = merged['telescope_pe_offsets']
+    assert pixel_offsets[-1] == len(merged['photoelectrons'])
+    assert pe_offsets[-1] == len(merged['time'])
+
+    for i, data in enumerate(expected):
+        assert merged['n_pe'][i] == data['n_pe']
+        assert merged['n_pixels'][i] == data['n_pixels']
+        pixels = slice(pixel_offsets[i], pixel_offsets[i + 1])
+        pes = slice(pe_offsets[i], pe_offsets[i + 1])
+        assert np.all(merged['photoelectrons'][pixels] == data['photoelectrons'])
+        assert np.all(merged['pixel_id'][pes] == data['pixel_id'])
+        assert np.all(merged['time'][pes] == data['time'])
+        assert np.all(
+            merged['pixel_offsets'][pixel_offsets[i]:pixel_offsets[i + 1] + 1]
+            == data['pixel_offsets'] + pe_offsets[i]
+        )
+
+
 def test_file_has_run_header():
     from eventio.iact import RunHeader
     with eventio.EventIOFile(testfile) as f:
@@ -112,6 +150,28 @@ def test_event_has_382_bunches():
         assert photons.n_bunches == 382
 
 
+def test_photons_lazy_bunch_header():
+    from eventio.iact import TelescopeData
+
+    with eventio.EventIOFile(testfile) as f:
+        for i in range(6):
+            obj = next(f)
+
+        assert isinstance(obj, TelescopeData)
+        assert not hasattr(obj, '__dict__')
+
+        photons = next(obj)
+        assert not hasattr(photons, '__dict__')
+        # nothing is read before the bunch header is accessed
+        assert photons._bunch_header is None
+        assert photons.tell() == 0
+
+        bunches, _ = photons.parse()
+        assert photons.n_bunches == len(bunches) == 382
+        assert photons.array == photons.array_id
+        assert photons.telescope == photons.telescope_id
+
+
 def test_bunches():
     from eventio.iact import TelescopeData
 
@@ -172,3 +232,24 @@ def test_atmospheric_profile():
         assert np.allclose(profile['rho'], atmprof8[:, 1])
         assert np.allclose(profile['thickness'], atmprof8[:, 2])
         assert np.allclose(profile['refractive_index_minus_1'], atmprof8[:, 3])
+
+
+def test_decode_compact_bunches():
+    from eventio.iact import Photons
+    from eventio.iact.parsing import decode_compact_bunches
+
+    rng = np.random.default_rng(0)
+    compact = rng.integers(-2**15, 2**15, (1000, 8)).astype(np.int16)
+    output = np.empty((1000, 8), dtype=np.float32)
+    decode_compact_bunches(compact, output)
+    result = output.view(Photons.long_dtype)[:, 0]
+
+    bunches = compact.view(Photons.compact_dtype)[:, 0]
+    assert result['x'] == approx(bunches['x'] * 0.1)
+    assert result['y'] == approx(bunches['y'] * 0.1)
+    assert result['cx'] == approx(np.clip(bunches['cx'] / 30000, -1, 1))
+    assert result['cy'] == approx(np.clip(bunches['cy'] / 30000, -1, 1))
+    assert result['time'] == approx(bunches['time'] * 0.1)
+    assert result['zem'] == approx(10**(bunches['zem'] * 0.001), rel=1e-6)
+    assert result['photons'] == approx(bunches['photons'] * 0.01)
+    assert np.all(result['wavelength'] == bunches['wavelength'])
@@ -0,0 +1,109 @@
+import asyncio
+import gzip
+import shutil
+import threading
+
+import pytest
+from eventio import SimTelFile
+
+from helpers import assert_simtel_events_equal
+
+prod2_path = 'tests/resources/gamma_test.simtel.gz'
+calib_path = 'tests/resources/calib_events.simtel.gz'
+
+
+@pytest.fixture(scope='module')
+def uncompressed_path(tmp_path_factory):
+    path = str(tmp_path_factory.mktemp('aio') / 'gamma_test.simtel')
+    with gzip.open(prod2_path, 'rb') as f_in, open(path, 'wb') as f_out:
+        shutil.copyfileobj(f_in, f_out)
+    return path
+
+
+async def collect(path, **kwargs):
+    from eventio.simtel.aio import AsyncSimTelFile
+
+    async with AsyncSimTelFile(path, **kwargs) as f:
+        return [event async for event in f]
+
+
+@pytest.mark.parametrize('path', [prod2_path, calib_path])
+@pytest.mark.parametrize('zcat', [True, False])
+def test_async_simtel_file(path, zcat):
+    with SimTelFile(path, zcat=zcat) as f:
+        expected = list(f)
+
+    events = asyncio.run(collect(path, zcat=zcat))
+    assert_simtel_events_equal(events, expected)
+
+
+def test_async_simtel_file_does_not_block():
+    from eventio.simtel.aio import AsyncSimTelFile
+
+    async def main():
+        ticks = 0
+        done = False
+
+        async def ticker():
+            nonlocal ticks
+            while not done:
+                ticks += 1
+                await asyncio.sleep(0)
+
+        task = asyncio.ensure_future(ticker())
+        n_events = 0
+        f = AsyncSimTelFile(prod2_path, allowed_telescopes={1, 2, 3, 4})
+        async for event in f:
+            assert set(event['telescope_events']) <= {1, 2, 3, 4}
+            n_events += 1
+        await f.close()
+        done = True
+        await task
+        return n_events, ticks
+
+    n_events, ticks = asyncio.run(main())
+    assert n_events > 0
+    # the event loop kept running while the file was read
+    assert ticks > n_events
+
+
+def test_async_simtel_file_fetch_overlaps_decode(monkeypatch, uncompressed_path):
+    from eventio.simtel import aio
+
+    condition = threading.Condition()
+    n_fetches = 0
+    n_decodes = 0
+    fetch_object = aio._fetch_object
+    decode = aio.AsyncSimTelFile._decode
+
+    def counting_fetch(f):
+        nonlocal n_fetches
+        with condition:
+            n_fetches += 1
+            condition.notify_all()
+        return fetch_object(f)
+
+    def waiting_decode(self, o):
+        nonlocal n_decodes
+        # the object after this one must be requested before this one is decoded
+        with condition:
+            assert condition.wait_for(lambda: n_fetches >= n_decodes + 2, timeout=10)
+            n_decodes += 1
+        return decode(self, o)
+
+    monkeypatch.setattr(aio, '_fetch_object', counting_fetch)
+    monkeypatch.setattr(aio.AsyncSimTelFile, '_decode', waiting_decode)
+
+    events = asyncio.run(collect(uncompressed_path))
+    assert len(events) > 0
+    assert n_decodes > len(events)
+
+
+def test_async_simtel_file_unsupported():
+    from eventio.simtel.aio import AsyncSimTelFile
+
+    with pytest.raises(ValueError):
+        AsyncSimTelFile(prod2_path, n_workers=2)
+
+    with pytest.raises(ValueError):
+        AsyncSimTelFile(prod2_path, instrumentation=True)
@@ -0,0 +1,62 @@
+import pytest
+from eventio import SimTelFile
+
+prod2_path = 'tests/resources/gamma_test.simtel.gz'
+camorgan_v2_path = 'tests/resources/test_camorganv2.simtel.gz'
+
+
+def event_ids(path):
+    with SimTelFile(path) as f:
+        return [e['event_id'] for e in f]
+
+
+@pytest.mark.parametrize('prefetch', [0, 1, 2])
+def test_chain(prefetch):
+    from eventio.simtel.chain import SimTelFileChain
+
+    paths = [prod2_path, camorgan_v2_path, prod2_path]
+    expected = []
+    for path in paths:
+        expected.extend((path, event_id) for event_id in event_ids(path))
+
+    with SimTelFileChain(paths, prefetch=prefetch) as chain:
+        assert len(chain) == 3
+        result = [(chain.current_path, e['event_id']) for e in chain]
+
+    assert result == expected
+    assert chain.current_file is None
+
+
+def test_chain_description_cache():
+    from eventio.simtel.chain import SimTelFileChain
+
+    descriptions = []
+    with SimTelFileChain([prod2_path, prod2_path]) as chain:
+        for f in chain.iter_files():
+            descriptions.append(f.telescope_descriptions)
+
+    assert len(chain.description_cache) > 0
+    first, second = descriptions
+    assert first.keys() == second.keys()
+    for tel_id, description in first.items():
+        # identical descriptions are only parsed once
+        assert description['camera_settings'] is second[tel_id]['camera_settings']
+        assert description['camera_organization'] is second[tel_id]['camera_organization']
+        # others are parsed for every file
+        if 'drive_settings' in description:
+            assert description['drive_settings'] is not second[tel_id]['drive_settings']
+
+    with SimTelFile(prod2_path) as f:
+        expected = f.telescope_descriptions[1]['camera_settings']
+    assert first[1]['camera_settings'].keys() == expected.keys()
+    assert first[1]['camera_settings']['n_pixels'] == expected['n_pixels']
+
+
+def test_chain_close_early():
+    from eventio.simtel.chain import SimTelFileChain
+
+    chain = SimTelFileChain([prod2_path] * 3, prefetch=2)
+    event = next(iter(chain))
+    assert 'telescope_events' in event
+    chain.close()
+    assert chain.current_file is None
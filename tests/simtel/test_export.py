@@ -0,0 +1,144 @@
+import numpy as np
+import pytest
+from eventio import SimTelFile
+
+prod2_path = 'tests/resources/gamma_test.simtel.gz'
+
+
+def expected_tables(path, **kwargs):
+    events = []
+    telescope_events = []
+    waveforms = {}
+
+    with SimTelFile(path, skip_calibration=True, **kwargs) as f:
+        for event in f:
+            events.append((
+                event['event_id'],
+                event['mc_shower']['energy'],
+                event['mc_event']['xcore'],
+                event['trigger_information']['n_telescopes_with_data'],
+            ))
+            for tel_id, tel_event in event['telescope_events'].items():
+                amplitude = np.nan
+                if 'image_parameters' in tel_event:
+                    amplitude = tel_event['image_parameters']['amplitude']
+                telescope_events.append((event['event_id'], tel_id, amplitude))
+
+                if 'adc_samples' in tel_event:
+                    waveforms.setdefault(tel_id, []).append(tel_event['adc_samples'])
+
+    return events, telescope_events, waveforms
+
+
+def check_tables(events, telescope_events, expected):
+    expected_events, expected_telescope_events, _ = expected
+
+    assert len(events['event_id']) == len(expected_events)
+    for i, (event_id, energy, xcore, n_tels) in enumerate(expected_events):
+        assert events['event_id'][i] == event_id
+        assert np.isclose(events['energy'][i], energy)
+        assert np.isclose(events['xcore'][i], xcore)
+        assert events['n_telescopes_with_data'][i] == n_tels
+
+    assert len(telescope_events['event_id']) == len(expected_telescope_events)
+    for i, (event_id, tel_id, amplitude) in enumerate(expected_telescope_events):
+        assert telescope_events['event_id'][i] == event_id
+        assert telescope_events['telescope_id'][i] == tel_id
+        assert np.isclose(telescope_events['amplitude'][i], amplitude, equal_nan=True)
+
+
+def test_column_buffer():
+    from eventio.simtel.export import ColumnBuffer
+
+    class Writer:
+        def __init__(self):
+            self.batches = []
+
+        def write_batch(self, table, columns):
+            self.batches.append((table, {k: v.copy() for k, v in columns.items()}))
+
+    writer = Writer()
+    buffer = ColumnBuffer(writer, 'test', [('a', np.int16), ('b', np.float32)], batch_size=2)
+
+    buffer.append({'a': 1, 'b': 2.0})
+    assert writer.batches == []
+    buffer.append({'a': 2, 'b': 3.0}, {'a': 3})
+    buffer.append({})
+    buffer.flush()
+    buffer.flush()
+
+    assert buffer.n_rows_written == 3
+    assert [table for table, _ in writer.batches] == ['test', 'test']
+    assert writer.batches[0][1]['a'].tolist() == [1, 3]
+    assert writer.batches[0][1]['b'].tolist() == [2.0, 3.0]
+    assert writer.batches[1][1]['a'].tolist() == [-1]
+    assert np.isnan(writer.batches[1][1]['b'][0])
+
+
+@pytest.mark.parametrize('format', ['parquet', 'arrow'])
+def test_export_arrow(tmp_path, format):
+    pa = pytest.importorskip('pyarrow')
+    from eventio.simtel.export import export_simtel
+
+    expected = expected_tables(prod2_path)
+    output = tmp_path / 'gamma_test'
+    n_events = export_simtel(
+        prod2_path, str(output), format=format, waveforms=True, batch_size=3
+    )
+    assert n_events == len(expected[0])
+
+    def read(table):
+        path = str(output / '{}.{}'.format(table, format))
+        if format == 'parquet':
+            import pyarrow.parquet as pq
+            return pq.read_table(path)
+        return pa.ipc.open_file(path).read_all()
+
+    events = read('events').to_pydict()
+    telescope_events = read('telescope_events').to_pydict()
+    check_tables(events, telescope_events, expected)
+
+    for tel_id, adc_samples in expected[2].items():
+        table = read('waveforms_tel_{:03d}'.format(tel_id))
+        field = table.schema.field('waveforms')
+        shape = tuple(int(s) for s in field.metadata[b'shape'].split(b','))
+
+        waveforms = np.array(table.column('waveforms').to_pylist()).reshape((-1, ) + shape)
+        assert len(waveforms) == len(adc_samples)
+        for exported, samples in zip(waveforms, adc_samples):
+            assert np.all(exported.reshape(samples.shape) == samples)
+
+
+def test_export_hdf5(tmp_path):
+    h5py = pytest.importorskip('h5py')
+    from eventio.simtel.export import export_simtel
+
+    telescopes = {1, 2, 3, 4, 5, 38}
+    expected = expected_tables(prod2_path, allowed_telescopes=telescopes)
+    output = str(tmp_path / 'gamma_test.h5')
+
+    n_events = export_simtel(
+        prod2_path, output, waveforms=True, batch_size=4, allowed_telescopes=telescopes,
+    )
+    assert n_events == len(expected[0])
+
+    with h5py.File(output, 'r') as f:
+        events = {k: v[:] for k, v in f['events'].items()}
+        telescope_events = {k: v[:] for k, v in f['telescope_events'].items()}
+        check_tables(events, telescope_events, expected)
+
+        assert set(f['waveforms'].keys()) == {
+            'tel_{:03d}'.format(tel_id) for tel_id in expected[2]
+        }
+        for tel_id, adc_samples in expected[2].items():
+            waveforms = f['waveforms/tel_{:03d}/waveforms'.format(tel_id)][:]
+            assert len(waveforms) == len(adc_samples)
+            for exported, samples in zip(waveforms, adc_samples):
+                assert np.all(exported.reshape(samples.shape) == samples)
+
+
+def test_unknown_format(tmp_path):
+    from eventio.simtel.export import export_simtel
+
+    with pytest.raises(ValueError):
+        export_simtel(prod2_path, str(tmp_path / 'out'), format='csv')
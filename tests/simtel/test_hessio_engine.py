@@ -0,0 +1,76 @@
+import struct
+
+import numpy as np
+import pytest
+from eventio import SimTelFile
+
+prod2_path = 'tests/resources/gamma_test.simtel.gz'
+prod4_path = 'tests/resources/gamma_20deg_0deg_run102___cta-prod4-sst-1m_desert-2150m-Paranal-sst-1m.simtel.gz'
+
+
+def test_unknown_engine():
+    with pytest.raises(ValueError):
+        SimTelFile(prod2_path, engine='foo')
+
+
+@pytest.mark.parametrize('path', [prod2_path, prod4_path])
+@pytest.mark.parametrize('lazy', [False, True])
+def test_hessio_engine(path, lazy):
+    pytest.importorskip('eventio.simtel.hessio')
+
+    with SimTelFile(path) as f, SimTelFile(path, engine='hessio', lazy_telescope_events=lazy) as h:
+        n_events = 0
+        for expected, event in zip(f, h):
+            assert event['event_id'] == expected['event_id']
+            assert event['telescope_events'].keys() == expected['telescope_events'].keys()
+
+            for tel_id, telescope_event in event['telescope_events'].items():
+                for key in ('adc_samples', 'adc_sums'):
+                    if key in expected['telescope_events'][tel_id]:
+                        value = telescope_event[key]
+                        expected_value = expected['telescope_events'][tel_id][key]
+                        assert value.dtype == expected_value.dtype
+                        assert np.array_equal(value, expected_value)
+
+            n_events += 1
+            if n_events == 5:
+                break
+
+    assert n_events == 5
+
+
+def test_hessio_adc_samples_zero_suppressed():
+    hessio = pytest.importorskip('eventio.simtel.hessio')
+    from eventio.simtel.parsing import parse_adc_samples
+
+    # 2 gains, 5 pixels, 3 samples, pixel list: single pixel 1, range 3 to 4
+    data = struct.pack('<ihh', 5, 2, 3)
+    data += bytes([2 * 2, 1 * 2 + 1, 3 * 2, 4 * 2])
+    # differences of 1, giving the samples 1, 2, 3 for each of the 3 pixels and 2 gains
+    data += 6 * bytes([2, 2, 2])
+
+    adc_samples, bytes_read = hessio.parse_adc_samples(data, True)
+    expected, expected_bytes_read = parse_adc_samples(data, True)
+    assert bytes_read == expected_bytes_read == len(data)
+    assert np.array_equal(adc_samples, expected)
+    assert np.all(adc_samples[:, [0, 2]] == 0)
+    assert np.all(adc_samples[:, [1, 3, 4]] == [1, 2, 3])
+
+    with pytest.raises(IndexError):
+        hessio.parse_adc_samples(data[:-1], True)
+
+
+def test_hessio_adc_sums():
+    hessio = pytest.importorskip('eventio.simtel.hessio')
+    from eventio.var_int import unsigned_varint_arrays_differential
+
+    # two byte differences and a negative difference
+    data = struct.pack('<ih', 3, 1) + bytes([0x81, 0x00, 3, 0x80, 0x02])
+    adc_sums, bytes_read = hessio.parse_adc_sums(data)
+    expected, expected_bytes_read = unsigned_varint_arrays_differential(data, 1, 3, offset=6)
+    assert bytes_read == expected_bytes_read == len(data)
+    assert np.array_equal(adc_sums, expected)
+    assert adc_sums.tolist() == [[128, 126, 127]]
+
+    with pytest.raises(IndexError):
+        hessio.parse_adc_sums(data[:-1])
@@ -0,0 +1,95 @@
+import gzip
+import shutil
+
+import numpy as np
+import pytest
+from eventio import SimTelFile
+
+prod2_path = 'tests/resources/gamma_test.simtel.gz'
+
+
+@pytest.fixture(scope='module')
+def uncompressed_path(tmp_path_factory):
+    path = str(tmp_path_factory.mktemp('scan') / 'gamma_test.simtel')
+    with gzip.open(prod2_path, 'rb') as f_in, open(path, 'wb') as f_out:
+        shutil.copyfileobj(f_in, f_out)
+    return path
+
+
+@pytest.mark.parametrize('compressed', [True, False])
+def test_scan_event_metadata(compressed, uncompressed_path):
+    from eventio.simtel.scan import scan_event_metadata
+
+    path = prod2_path if compressed else uncompressed_path
+    tables = scan_event_metadata(path, index_cache=False)
+    showers = tables['showers']
+    mc_events = tables['mc_events']
+    triggers = tables['triggers']
+
+    expected_showers = {}
+    expected_mc_events = []
+    expected_triggers = []
+    with SimTelFile(path, skip_calibration=True) as f:
+        for event in f:
+            shower = event['mc_shower']
+            expected_showers[shower['shower']] = shower
+            expected_mc_events.append((event['event_id'], event['mc_event']))
+            expected_triggers.append((event['event_id'], event['trigger_information']))
+
+    assert len(triggers) == len(expected_triggers)
+    for row, (event_id, trigger) in zip(triggers, expected_triggers):
+        assert row['event_id'] == event_id
+        assert (row['cpu_time_s'], row['cpu_time_ns']) == trigger['cpu_time']
+        assert row['trigger_pattern'] == trigger['trigger_pattern']
+        assert row['n_triggered_telescopes'] == trigger['n_triggered_telescopes']
+        assert row['n_telescopes_with_data'] == trigger['n_telescopes_with_data']
+
+    rows = {shower_id: row for shower_id, row in zip(showers['shower_id'], showers)}
+    for shower_id, shower in expected_showers.items():
+        row = rows[shower_id]
+        for key in ('primary_id', 'energy', 'azimuth', 'altitude', 'xmax', 'hmax'):
+            assert row[key] == np.float32(shower[key])
+
+    mc_rows = {event_id: row for event_id, row in zip(mc_events['event_id'], mc_events)}
+    assert len(mc_events) >= len(expected_mc_events)
+    assert np.count_nonzero(mc_events['triggered']) == len(expected_mc_events)
+    for event_id, mc_event in expected_mc_events:
+        row = mc_rows[event_id]
+        assert row['triggered']
+        assert row['shower_id'] == mc_event['shower_num']
+        assert row['xcore'] == np.float32(mc_event['xcore'])
+        assert row['aweight'] == np.float32(mc_event['aweight'])
+
+
+
+def test_scan_compressed_reads_once(monkeypatch, tmp_path):
+    from eventio.simtel import scan
+
+    path = str(tmp_path / 'gamma_test.simtel.gz')
+    shutil.copyfile(prod2_path, path)
+
+    def read_again(*args, **kwargs):
+        raise AssertionError('File was read a second time')
+
+    # without a cached index, the payloads are collected while building it
+    with monkeypatch.context() as m:
+        m.setattr(scan, '_read_tables', read_again)
+        tables = scan.scan_event_metadata(path)
+
+    # now the cached index is used and the payloads are read from the file
+    read_tables = scan._read_tables
+    calls = []
+
+    def counting_read_tables(*args, **kwargs):
+        calls.append(args)
+        return read_tables(*args, **kwargs)
+
+    with monkeypatch.context() as m:
+        m.setattr(scan, '_read_tables', counting_read_tables)
+        expected = scan.scan_event_metadata(path)
+    assert len(calls) == 1
+
+    for key, table in tables.items():
+        for name in table.dtype.names:
+            equal_nan = table[name].dtype.kind == 'f'
+            assert np.array_equal(table[name], expected[key][name], equal_nan=equal_nan)
@@ -136,6 +136,11 @@ def test_2003_3_objects():
             cam_organ = parse_and_assert_consumption(o, limit=1)
             assert cam_organ['telescope_id'] == i + 1
 
+            offsets = cam_organ['sector_offsets']
+            assert len(offsets) == cam_organ['n_pixels'] + 1
+            assert offsets[-1] == len(cam_organ['sector_indices'])
+            assert len(cam_organ['sectors']) == cam_organ['n_pixels']
+
             for sector in cam_organ['sectors']:
                 # sector must never contain a zero, unless it is in the
                 # very first element
@@ -143,6 +148,23 @@ def test_2003_3_objects():
                 # print(pixel_id, sector)
 
 
+def test_read_sector_information_v1():
+    import struct
+    from eventio.simtel.parsing import read_sector_information_v1
+
+    sectors = [[1, 2, 3], [], [5]]
+    data = b''.join(struct.pack('<h{}h'.format(len(s)), len(s), *s) for s in sectors)
+
+    result, length = read_sector_information_v1(data, len(sectors))
+    assert length == len(data)
+    assert result.offsets.tolist() == [0, 3, 3, 4]
+    assert result.values.dtype == np.int16
+    assert [r.tolist() for r in result] == sectors
+
+    with pytest.raises(IndexError):
+        read_sector_information_v1(data[:-1], len(sectors))
+
+
 def test_2003_v2():
     from eventio.simtel.objects import CameraOrganization
 
@@ -154,6 +176,11 @@ def test_2003_v2():
             cam_organ = parse_and_assert_consumption(o, limit=1)
             assert cam_organ['telescope_id'] == i + 1
 
+            offsets = cam_organ['sector_offsets']
+            assert len(offsets) == cam_organ['n_pixels'] + 1
+            assert offsets[-1] == len(cam_organ['sector_indices'])
+            assert len(cam_organ['sectors']) == cam_organ['n_pixels']
+
             for sector in cam_organ['sectors']:
                 # sector must never contain a zero, unless it is in the
                 # very first element
@@ -279,6 +306,30 @@ def test_2009():
             assert comp['speed_of_light'] == approx(29.97, abs=0.01)
 
 
+def test_parse_trigger_information():
+    import struct
+    from eventio.simtel.parsing import parse_trigger_information
+
+    data = struct.pack('<iiiiii', 1, 2, 3, 4, 5, 6)
+    data += struct.pack('<h2h2f', 2, 7, 9, 1.5, 2.5)
+    data += struct.pack('<h1h', 1, 9)
+    data += struct.pack('<2B2f', 0b001, 0b101, 3.0, 4.0)
+
+    info = parse_trigger_information(data, 2)
+    assert info['cpu_time'] == (1, 2)
+    assert info['gps_time'] == (3, 4)
+    assert info['trigger_pattern'] == 5
+    assert info['data_pattern'] == 6
+    assert info['triggered_telescopes'].tolist() == [7, 9]
+    assert info['trigger_times'].tolist() == [1.5, 2.5]
+    assert info['telescopes_with_data'].tolist() == [9]
+    assert info['teltrg_type_mask'].tolist() == [1, 5]
+    assert info['teltrg_time_by_type'] == {9: {0: 3.0, 2: 4.0}}
+
+    with pytest.raises(IndexError):
+        parse_trigger_information(data[:-1], 2)
+
+
 def test_2100_3_objects():
     from eventio.simtel.objects import TrackingPosition
 
@@ -316,7 +367,15 @@ def test_2011():
 
     with EventIOFile(prod2_file) as f:
         for i, o in enumerate(yield_n_and_assert(f, TelescopeEventHeader, n=3)):
-            parse_and_assert_consumption(o, limit=2)
+            d = parse_and_assert_consumption(o, limit=2)
+            assert d['telescope_id'] == o.telescope_id
+
+            if i == 0:
+                assert d['glob_count'] == 408
+                assert d['cpu_time'] == (1408549473, 35597000)
+                assert d['trg_source'] == 1
+                assert d['list_trgsect'].tolist() == [174, 175, 198, 199]
+                assert d['time_trgsect'] == approx(37.537537)
 
             # print(d)
         # a few printed examples: only version 1!!
@@ -409,6 +468,70 @@ def test_2013_3_objects():
                 assert (d == expected_adc_samples_event1_tel_id_38).all()
 
 
+def test_2013_3_parse_into():
+    from collections import defaultdict
+    from eventio.search_utils import yield_subobjects
+    from eventio.simtel.objects import ADCSamples
+
+    # the gzip module allows seeking back to parse the objects again
+    with EventIOFile(prod2_file, zcat=False) as f:
+        by_telescope = defaultdict(list)
+        for o in yield_subobjects(f, ADCSamples):
+            expected = np.atleast_3d(o.parse())
+            output = np.full(o.shape, 0xffff, dtype=np.uint16)
+            assert o.parse_into(output) is output
+            assert np.array_equal(output, expected)
+            by_telescope[o.telescope_id].append((o, expected))
+
+            with pytest.raises(ValueError):
+                o.parse_into(np.empty((1, 1, 1), dtype=np.uint16))
+
+        # all objects of one telescope have the same shape
+        objects = max(by_telescope.values(), key=len)
+        assert len(objects) > 1
+        output = np.full((len(objects), ) + objects[0][1].shape, 0xffff, dtype=np.uint16)
+        ADCSamples.parse_batch([o for o, _ in objects], output)
+        for out, (_, expected) in zip(output, objects):
+            assert np.array_equal(out, expected)
+
+        with pytest.raises(ValueError):
+            ADCSamples.parse_batch([o for o, _ in objects], output[:1])
+
+
+def test_2013_3_parse_batch_zero_suppressed():
+    import struct
+    from eventio.simtel.parsing import parse_adc_samples, parse_adc_samples_batch
+
+    # 2 gains, 5 pixels, 3 samples, differences of 1 giving the samples 1, 2, 3
+    header = struct.pack('<ihh', 5, 2, 3)
+    # pixel list: single pixel 1, range 3 to 4
+    zero_suppressed = header + bytes([2 * 2, 1 * 2 + 1, 3 * 2, 4 * 2]) + 6 * bytes([2, 2, 2])
+    full = header + 10 * bytes([2, 2, 2])
+
+    payloads = [zero_suppressed, full, zero_suppressed]
+    flags = [True, False, True]
+    output = np.full((3, 2, 5, 3), 0xffff, dtype=np.uint16)
+    assert parse_adc_samples_batch(payloads, flags, output) is output
+
+    for out, data, zs in zip(output, payloads, flags):
+        expected, _ = parse_adc_samples(data, zs)
+        assert np.array_equal(out, expected)
+
+    # pixels not in the pixel list are overwritten with 0
+    assert np.all(output[[0, 2]][:, :, [0, 2]] == 0)
+    assert np.all(output[[0, 2]][:, :, [1, 3, 4]] == [1, 2, 3])
+    assert np.all(output[1] == [1, 2, 3])
+
+    with pytest.raises(ValueError):
+        parse_adc_samples_batch(payloads, flags, np.empty((3, 1, 5, 3), dtype=np.uint16))
+
+    with pytest.raises(ValueError):
+        parse_adc_samples_batch(payloads, flags[:2], output)
+
+    with pytest.raises(IndexError):
+        parse_adc_samples_batch([zero_suppressed[:-1]], [True], output[:1])
+
+
 def test_2014_3_objects():
     from eventio.simtel.objects import ImageParameters
 
@@ -696,3 +819,24 @@ def test_2032():
             assert 'n_times' in d
             assert 'pixel_ids' in d
             assert 'trigger_times' in d
+
+
+def test_slots():
+    from eventio.simtel.objects import ArrayEvent, TelescopeEvent, ADCSamples, TrackingPosition
+
+    with EventIOFile(prod2_file) as f:
+        array_event = next(yield_toplevel_of_type(f, ArrayEvent))
+        trigger_information = next(array_event)
+        assert not hasattr(trigger_information, '__dict__')
+        assert trigger_information.global_count == trigger_information.header.id
+
+        for o in array_event:
+            assert not hasattr(o, '__dict__')
+            if isinstance(o, TelescopeEvent):
+                assert o.telescope_id == TelescopeEvent.type_to_telid(o.header.type)
+                for sub in o:
+                    assert not hasattr(sub, '__dict__')
+                    if isinstance(sub, ADCSamples):
+                        assert sub.telescope_id == o.telescope_id
+            elif isinstance(o, TrackingPosition):
+                assert o.telescope_id == TrackingPosition.type_to_telid(o.header.type)
@@ -1,6 +1,8 @@
-from pytest import importorskip
+from pytest import importorskip, raises
 from eventio.simtel import SimTelFile
 
+from helpers import assert_simtel_events_equal
+
 prod2_path = 'tests/resources/gamma_test.simtel.gz'
 prod3_path = 'tests/resources/gamma_test_large_truncated.simtel.gz'
 prod4_path = 'tests/resources/gamma_20deg_0deg_run102___cta-prod4-sst-1m_desert-2150m-Paranal-sst-1m.simtel.gz'
@@ -185,6 +187,59 @@ def test_calibration_events():
         assert i >= 1
 
 
+def test_calibration_events_allowed_telescopes():
+    with SimTelFile(calib_path) as f:
+        all_telescopes = [set(e['telescope_events']) for e in f]
+
+    allowed_telescopes = {min(set.union(*all_telescopes))}
+    expected = sum(bool(t & allowed_telescopes) for t in all_telescopes)
+
+    with SimTelFile(calib_path, allowed_telescopes=allowed_telescopes) as f:
+        i = 0
+        for event in f:
+            assert event['type'] == 'calibration'
+            assert set(event['telescope_events']) == allowed_telescopes
+            i += 1
+
+        assert i == expected
+        # monitoring data of other telescopes is not parsed
+        assert set(f.camera_monitorings) <= allowed_telescopes
+        assert set(f.laser_calibrations) <= allowed_telescopes
+
+
+def test_monitoring_snapshots():
+    import pickle
+    from eventio.simtel.simtelfile import EMPTY_MONITORING, MonitoringSnapshot
+
+    with SimTelFile(calib_path) as f:
+        for event in f:
+            for t in event['telescope_events'].keys():
+                monitoring = event['camera_monitorings'][t]
+                assert isinstance(monitoring, MonitoringSnapshot)
+                # events share the current snapshot instead of copies
+                assert monitoring is f.camera_monitorings[t]
+                assert event['laser_calibrations'][t] is f.laser_calibrations[t]
+
+            with raises(TypeError):
+                monitoring['pedestal'] = 0
+
+    restored = pickle.loads(pickle.dumps(monitoring))
+    assert restored.version == monitoring.version
+    assert restored.keys() == monitoring.keys()
+
+    # telescopes without monitoring data give an empty snapshot
+    assert f.camera_monitorings[-1] is EMPTY_MONITORING
+    assert f.laser_calibrations[-1] is EMPTY_MONITORING
+    assert -1 not in f.camera_monitorings
+    assert -1 not in f.laser_calibrations
+
+    snapshot = MonitoringSnapshot({'a': 1, 'b': 2})
+    updated = snapshot.updated({'b': 3})
+    assert dict(snapshot) == {'a': 1, 'b': 2}
+    assert dict(updated) == {'a': 1, 'b': 3}
+    assert updated.version == snapshot.version + 1
+
+
 def test_skip_calibration_events():
     with SimTelFile(calib_path, skip_calibration=True) as f:
         i = 0
@@ -228,3 +283,198 @@ def test_photons():
         # no emitter info in file
         print(e['emitter'])
         assert len(e['emitter']) == 0
+
+
+def test_photons_allowed_telescopes():
+    # photons are stored by telescope index, which is telescope id - 1
+    with SimTelFile('tests/resources/lst_with_photons.simtel.zst', allowed_telescopes={1}) as f:
+        e = next(iter(f))
+        assert set(e['photons']) == {0}
+
+    with SimTelFile('tests/resources/lst_with_photons.simtel.zst', allowed_telescopes={2}) as f:
+        assert len(f.current_photons) == 0
+        for e in f.iter_mc_events():
+            assert len(e['photons']) == 0
+
+
+def test_random_access(tmp_path):
+    import os
+    import shutil
+    import numpy as np
+    from eventio.index import EventIOIndex
+
+    path = str(tmp_path / 'events.simtel.gz')
+    shutil.copy(prod4_path, path)
+
+    with SimTelFile(path, zcat=False) as f:
+        events = {e['event_id']: e for e in f}
+
+    event_ids = list(events)
+    assert len(event_ids) > 2
+
+    with SimTelFile(path, zcat=False) as f:
+        assert len(f.event_index) == len(events)
+        assert os.path.isfile(EventIOIndex.index_path(path))
+
+        # backwards, forwards and repeated access
+        for event_id in event_ids[::-1] + event_ids[:2] + event_ids[:1]:
+            event = f[event_id]
+            expected = events[event_id]
+            assert event['event_id'] == event_id
+            assert event['mc_shower']['shower'] == expected['mc_shower']['shower']
+            assert event['mc_event'] == expected['mc_event']
+            assert event['telescope_events'].keys() == expected['telescope_events'].keys()
+            assert f.event_index.telescope_events(event_id).keys() == event['telescope_events'].keys()
+
+            for tel_id, telescope_event in event['telescope_events'].items():
+                for key in ('adc_samples', 'adc_sums'):
+                    if key in telescope_event:
+                        assert np.all(telescope_event[key] == expected['telescope_events'][tel_id][key])
+
+        # seek_event continues normal iteration at the requested event
+        f.seek_event(event_ids[1])
+        assert [e['event_id'] for e in f] == event_ids[1:]
+
+        try:
+            f[-1]
+        except KeyError:
+            pass
+        else:
+            raise AssertionError('Expected KeyError for missing event')
+
+
+def test_random_access_monitoring(tmp_path):
+    from eventio import EventIOFile
+    from eventio.simtel.objects import ArrayEvent, CameraMonitoring
+    from eventio.simtel.simtelfile import EMPTY_MONITORING
+    from eventio.writer import EventIOWriter, read_payload
+
+    # move the first camera monitoring behind the first event,
+    # so its telescope has no monitoring data for that event
+    path = str(tmp_path / 'late_monitoring.simtel')
+    moved = None
+    with EventIOFile(prod4_path) as f, EventIOWriter(path) as writer:
+        for o in f:
+            if moved is None and isinstance(o, CameraMonitoring):
+                moved = (o.header, read_payload(o))
+                telescope_id = o.telescope_id
+                continue
+
+            writer.write_object(o)
+            if moved is not None and isinstance(o, ArrayEvent):
+                writer.write(*moved)
+                moved = ()
+
+    with SimTelFile(path) as f:
+        has_monitoring = {e['event_id']: telescope_id in f.camera_monitorings for e in f}
+
+    event_ids = list(has_monitoring)
+    assert not has_monitoring[event_ids[0]]
+    assert has_monitoring[event_ids[-1]]
+
+    with SimTelFile(path) as f:
+        # forwards past the monitoring update and back in front of it
+        for event_id in (event_ids[0], event_ids[-1], event_ids[0], event_ids[1]):
+            assert f[event_id]['event_id'] == event_id
+            assert (telescope_id in f.camera_monitorings) == has_monitoring[event_id]
+            if not has_monitoring[event_id]:
+                assert f.camera_monitorings[telescope_id] is EMPTY_MONITORING
+
+
+def test_index_cache(tmp_path):
+    import os
+    import shutil
+    from eventio.index import EventIOIndex
+
+    path = str(tmp_path / 'events.simtel.gz')
+    shutil.copy(prod4_path, path)
+    index_path = EventIOIndex.index_path(path)
+
+    index = EventIOIndex.for_file(path)
+    assert os.path.isfile(index_path)
+
+    loaded = EventIOIndex.load(index_path)
+    assert loaded.is_valid_for(path, max_depth=1)
+    assert (loaded.objects == index.objects).all()
+    assert loaded.end == index.end
+
+    # a changed file invalidates the index
+    stat = os.stat(path)
+    os.utime(path, ns=(stat.st_atime_ns, stat.st_mtime_ns + 1_000_000_000))
+    assert not loaded.is_valid_for(path)
+
+    index = EventIOIndex.for_file(path)
+    assert EventIOIndex.load(index_path).is_valid_for(path)
+
+
+def test_random_access_zst(tmp_path):
+    import shutil
+    importorskip('zstandard')
+
+    path = str(tmp_path / 'events.simtel.zst')
+    shutil.copy(prod4_zst_path, path)
+
+    with SimTelFile(path) as f:
+        event_ids = [e['event_id'] for e in f]
+
+    with SimTelFile(path, seekable=True) as f:
+        for event_id in (event_ids[-1], event_ids[0], event_ids[1]):
+            assert f[event_id]['event_id'] == event_id
+
+
+def test_parallel_decoding():
+    with SimTelFile(prod4_path) as f:
+        expected = list(f)
+
+    with SimTelFile(prod4_path, n_workers=2) as f:
+        events = list(f)
+
+    assert_simtel_events_equal(events, expected)
+
+
+def test_parallel_decoding_allowed_telescopes():
+    allowed_telescopes = {1, 2, 3, 4}
+    with SimTelFile(prod2_path, allowed_telescopes=allowed_telescopes) as f:
+        expected = [
+            (e['event_id'], set(e['telescope_events'])) for e in f
+        ]
+
+    with SimTelFile(prod2_path, allowed_telescopes=allowed_telescopes, n_workers=2) as f:
+        events = [
+            (e['event_id'], set(e['telescope_events'])) for e in f
+        ]
+
+    assert events == expected
+
+
+def test_lazy_telescope_events():
+    from eventio.simtel.simtelfile import LazyTelescopeEvent
+
+    with SimTelFile(prod4_path) as f:
+        expected = list(f)
+
+    with SimTelFile(prod4_path, lazy_telescope_events=True) as f:
+        events = list(f)
+
+    assert len(events) == len(expected)
+    for event, expected_event in zip(events, expected):
+        assert event['telescope_events'].keys() == expected_event['telescope_events'].keys()
+
+        for tel_id, telescope_event in event['telescope_events'].items():
+            assert isinstance(telescope_event, LazyTelescopeEvent)
+            assert not telescope_event.is_parsed('adc_samples')
+
+            expected_telescope_event = expected_event['telescope_events'][tel_id]
+            assert set(telescope_event) == set(expected_telescope_event)
+            header = telescope_event['header']
+            assert header['glob_count'] == expected_telescope_event['header']['glob_count']
+            assert header['gps_time'] == expected_telescope_event['header']['gps_time']
+            assert not telescope_event.is_parsed('adc_samples')
+
+    # accessing the adc samples parses them
+    assert_simtel_events_equal(events, expected)
+    for event, expected_event in zip(events, expected):
+        for tel_id, telescope_event in event['telescope_events'].items():
+            expected_telescope_event = expected_event['telescope_events'][tel_id]
+            assert telescope_event.is_parsed('adc_samples')
+            assert telescope_event['pixel_lists'].keys() == expected_telescope_event['pixel_lists'].keys()
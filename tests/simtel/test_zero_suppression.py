@@ -1,4 +1,5 @@
 from os import path, environ
+import struct
 import pytest
 import numpy as np
 from eventio import SimTelFile
@@ -60,3 +61,74 @@ def test_adc_samples():
                     )
 
     assert seen_at_least_one_event
+
+
+def encode_differential(values):
+    '''zig-zag encoded differences as varints, only for small differences'''
+    data = b''
+    previous = 0
+    for value in values:
+        diff = int(value) - previous
+        previous = int(value)
+        u = 2 * diff if diff >= 0 else -2 * diff - 1
+        assert u < 2**14
+        if u < 0x80:
+            data += bytes([u])
+        else:
+            data += bytes([0x80 | (u >> 8), u & 0xff])
+    return data
+
+
+def test_adc_sums_zero_sup_mode_1():
+    from eventio.simtel.parsing import parse_adc_sums_zero_suppressed
+
+    n_pixels, n_gains = 20, 2
+    rng = np.random.default_rng(0)
+    expected = np.zeros((n_gains, n_pixels))
+
+    data = struct.pack('<ih', n_pixels, n_gains)
+    for start in range(0, n_pixels, 16):
+        n = min(16, n_pixels - start)
+        selected = rng.random(n) < 0.5
+        zbits = sum(1 << j for j in np.nonzero(selected)[0])
+        values = rng.integers(0, 1000, (n_gains, selected.sum()))
+        expected[:, start:start + n][:, selected] = values
+
+        data += struct.pack('<h', zbits - (1 << 16) if zbits >= 2**15 else zbits)
+        data += encode_differential(values[1]) + encode_differential(values[0])
+
+    adc_sums, bytes_read = parse_adc_sums_zero_suppressed(data, 1)
+    assert bytes_read == len(data)
+    assert adc_sums.dtype == np.float64
+    assert np.all(adc_sums == expected)
+
+    with pytest.raises(IndexError):
+        parse_adc_sums_zero_suppressed(data[:-1], 1)
+
+
+def test_adc_sums_zero_sup_mode_2():
+    from eventio.simtel.parsing import parse_adc_sums_zero_suppressed
+
+    n_pixels, n_gains = 50, 2
+    # pixel id, without low gain, reduced width
+    pixels = [(3, False, False), (7, True, False), (10, True, True), (42, False, False)]
+    lg = [500, 12]
+    hg = [1000, 300, 2000]
+    hg8 = [17]
+
+    adc_list = [p | (0x2000 if wlg else 0) | (0x4000 if rw else 0) for p, wlg, rw in pixels]
+    data = struct.pack('<ihh', n_pixels, n_gains, len(adc_list))
+    data += struct.pack('<{}H'.format(len(adc_list)), *adc_list)
+    data += encode_differential(lg) + encode_differential(hg) + bytes(hg8)
+
+    expected = np.zeros((n_gains, n_pixels))
+    expected[0, [3, 7, 42]] = hg
+    expected[0, 10] = hg8[0]
+    expected[1, [3, 42]] = lg
+
+    adc_sums, bytes_read = parse_adc_sums_zero_suppressed(data, 2)
+    assert bytes_read == len(data)
+    assert np.all(adc_sums == expected)
+
+    with pytest.raises(IndexError):
+        parse_adc_sums_zero_suppressed(data[:-1], 2)
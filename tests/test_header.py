@@ -4,3 +4,89 @@ def test_repr():
     e = EventIOFile('tests/resources/gamma_test.simtel.gz')
     o = next(e)
     assert repr(o.header)
+
+
+def test_scan_objects():
+    from eventio import EventIOFile
+
+    testfile = 'tests/resources/one_shower.dat'
+    with EventIOFile(testfile) as f:
+        index, end = f.scan_objects()
+
+    with EventIOFile(testfile) as f:
+        objects = list(f)
+
+    assert len(index) == len(objects)
+    assert (index['depth'] == 0).all()
+    assert end == objects[-1].header.content_address + objects[-1].header.content_size
+
+    for row, o in zip(index, objects):
+        assert row['type'] == o.header.type
+        assert row['version'] == o.header.version
+        assert row['id'] == o.header.id
+        assert row['size'] == o.header.content_size
+        assert row['offset'] + row['header_size'] == o.header.content_address
+        assert row['only_subobjects'] == o.header.only_subobjects
+
+
+def test_scan_objects_nested():
+    from eventio import EventIOFile
+    from eventio.search_utils import yield_all_objects_depth_first
+
+    testfile = 'tests/resources/one_shower.dat'
+    with EventIOFile(testfile) as f:
+        index, end = f.scan_objects(max_depth=-1)
+
+    with EventIOFile(testfile) as f:
+        objects = list(yield_all_objects_depth_first(f))
+
+    assert len(index) == len(objects)
+    for row, (o, level) in zip(index, objects):
+        assert row['type'] == o.header.type
+        assert row['depth'] == level
+        assert row['offset'] + row['header_size'] == o.header.content_address
+
+    with EventIOFile(testfile) as f:
+        index_toplevel, _ = f.scan_objects(max_depth=0)
+        index_one_level, _ = f.scan_objects(max_depth=1)
+
+    assert (index[index['depth'] == 0] == index_toplevel).all()
+    assert (index[index['depth'] <= 1] == index_one_level).all()
+
+
+def test_scan_objects_compressed():
+    from eventio import EventIOFile
+
+    with EventIOFile('tests/resources/one_shower.dat') as f:
+        expected, expected_end = f.scan_objects(max_depth=-1)
+
+    with EventIOFile('tests/resources/one_shower.dat.gz') as f:
+        index, end = f.scan_objects(max_depth=-1)
+
+    assert end == expected_end
+    assert (index == expected).all()
+
+
+def test_scan_objects_truncated():
+    from eventio.header import scan_objects
+
+    with open('tests/resources/one_shower.dat', 'rb') as f:
+        data = f.read()
+
+    index, end = scan_objects(data)
+    truncated, truncated_end = scan_objects(data[:-10])
+
+    assert len(truncated) == len(index) - 1
+    assert (truncated == index[:-1]).all()
+    assert truncated_end == index[-1]['offset']
+
+
+def test_pickle():
+    import pickle
+    from eventio import EventIOFile
+
+    with EventIOFile('tests/resources/one_shower.dat') as f:
+        header = next(f).header
+
+    loaded = pickle.loads(pickle.dumps(header))
+    assert repr(loaded) == repr(header)
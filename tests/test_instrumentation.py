@@ -0,0 +1,69 @@
+from eventio import EventIOFile, SimTelFile
+
+simple_corsika = 'tests/resources/one_shower.dat'
+prod4_path = 'tests/resources/gamma_20deg_0deg_run103___cta-prod4-sst-astri_desert-2150m-Paranal-sst-astri.simtel.gz'
+
+
+def test_instrumentation_disabled():
+    with EventIOFile(simple_corsika) as f:
+        assert f.instrumentation is None
+        for o in f:
+            assert o._instrumentation is None
+
+
+def test_instrumentation():
+    with EventIOFile(simple_corsika, instrumentation=True) as f:
+        objects = []
+        for o in f:
+            objects.append((o.header.type, o.header.version, o.header.content_size))
+            if o.header.type == 1202:
+                o.parse()
+        stats = f.instrumentation.as_dict()
+
+    assert {(t, v, None) for t, v, _ in objects} == set(stats)
+    for t, v, size in objects:
+        assert stats[(t, v, None)]['n_objects'] == 1
+        assert stats[(t, v, None)]['n_bytes'] == size
+
+    event_header = next(s for (t, _, _), s in stats.items() if t == 1202)
+    assert event_header['name'] == 'EventHeader'
+    assert event_header['n_parsed'] == 1
+    assert event_header['parse_seconds'] > 0
+    assert event_header['io_seconds'] > 0
+    assert all(s['n_parsed'] == 0 for (t, _, _), s in stats.items() if t != 1202)
+
+
+def test_instrumentation_simtel():
+    with SimTelFile(prod4_path, instrumentation=True) as f:
+        for event in f:
+            pass
+        stats = f.instrumentation.as_dict()
+        prometheus = f.instrumentation.to_prometheus()
+
+    # ADC data is instrumented per zero suppression mode
+    adc = [key for key, s in stats.items() if s['name'] in ('ADCSamples', 'ADCSums')]
+    assert len(adc) > 0
+    assert all(variant.startswith('zero_sup_mode=') for _, _, variant in adc)
+
+    for key in adc:
+        assert stats[key]['n_parsed'] == stats[key]['n_objects']
+        assert stats[key]['parse_seconds'] > 0
+
+    assert '# TYPE eventio_parse_seconds_total counter' in prometheus
+    assert 'name="ADCSamples"' in prometheus or 'name="ADCSums"' in prometheus
+
+
+def test_shared_instrumentation():
+    from eventio.instrumentation import Instrumentation
+
+    instrumentation = Instrumentation()
+    for _ in range(2):
+        with EventIOFile(simple_corsika, instrumentation=instrumentation) as f:
+            for o in f:
+                pass
+
+    stats = instrumentation.as_dict()
+    assert all(s['n_objects'] == 2 for s in stats.values())
+
+    instrumentation.reset()
+    assert instrumentation.as_dict() == {}
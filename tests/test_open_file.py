@@ -1,7 +1,10 @@
 import eventio
+import pytest
 from os import path
 from itertools import zip_longest
 
+from helpers import object_contents, read_objects
+
 
 def test_is_install_folder_a_directory():
     dir_ = path.dirname(eventio.__file__)
@@ -63,3 +66,237 @@ def test_types_zcat():
     assert isinstance(f._filehandle, PipeWrapper)
     types = [o.header.type for o in f]
     assert types == [1200, 1212, 1201, 1202, 1203, 1204, 1209, 1210]
+
+
+def test_mmap():
+    from eventio.base import MemoryMappedFile
+    testfile = 'tests/resources/one_shower.dat'
+
+    f = eventio.EventIOFile(testfile)
+    assert isinstance(f._filehandle, MemoryMappedFile)
+    types = [o.header.type for o in f]
+    assert types == [1200, 1212, 1201, 1202, 1203, 1204, 1209, 1210]
+
+    f = eventio.EventIOFile(testfile, mmap=False)
+    assert not isinstance(f._filehandle, MemoryMappedFile)
+    types = [o.header.type for o in f]
+    assert types == [1200, 1212, 1201, 1202, 1203, 1204, 1209, 1210]
+
+
+def test_view():
+    testfile = 'tests/resources/one_shower.dat'
+
+    for use_mmap in (True, False):
+        with eventio.EventIOFile(testfile, mmap=use_mmap) as f:
+            for o in f:
+                view = o.view()
+                assert isinstance(view, memoryview)
+                assert len(view) == o.header.content_size
+                assert o.tell() == o.header.content_size
+
+                o.seek(0)
+                assert o.read() == view.tobytes()
+
+
+def test_seekable_gzip():
+    from eventio.compression import CheckpointedGzipReader
+
+    testfile = 'tests/resources/one_shower.dat'
+    expected = read_objects(testfile)
+
+    with eventio.EventIOFile(testfile + '.gz', seekable=True) as f:
+        assert isinstance(f._filehandle, CheckpointedGzipReader)
+        objects = list(f)
+        assert [o.header.type for o in objects] == [t for t, _ in expected]
+
+        # read objects in reverse order, requires seeking backwards
+        for o, (eventio_type, data) in zip(objects[::-1], expected[::-1]):
+            o.seek(0)
+            assert o.read() == data
+
+
+def test_checkpointed_gzip_reader(tmp_path):
+    import gzip
+    import numpy as np
+    from eventio.compression import CheckpointedGzipReader
+
+    rng = np.random.default_rng(0)
+    data = rng.integers(0, 4, 1_000_000, dtype=np.uint8).tobytes()
+
+    # multi member file
+    path = tmp_path / 'test.gz'
+    with open(path, 'wb') as f:
+        f.write(gzip.compress(data[:300_000]))
+        f.write(gzip.compress(data[300_000:]))
+
+    reader = CheckpointedGzipReader(path, checkpoint_spacing=50_000)
+    assert reader.read() == data
+    assert len(reader.checkpoints) > 10
+
+    for pos in rng.integers(0, len(data), 100):
+        assert reader.seek(pos) == pos
+        assert reader.read(1000) == data[pos:pos + 1000]
+
+    assert reader.seek(len(data) + 10) == len(data)
+    assert reader.seek(-10, 2) == len(data) - 10
+    assert reader.read() == data[-10:]
+    reader.close()
+
+
+def test_checkpointed_zstd_reader(tmp_path):
+    import numpy as np
+    from pytest import importorskip
+    from eventio.compression import CheckpointedZstdReader
+
+    zstd = importorskip('zstandard')
+
+    rng = np.random.default_rng(0)
+    data = rng.integers(0, 4, 1_000_000, dtype=np.uint8).tobytes()
+
+    # multiple frames plus a skippable frame
+    path = tmp_path / 'test.zst'
+    cctx = zstd.ZstdCompressor()
+    with open(path, 'wb') as f:
+        for start in range(0, len(data), 100_000):
+            f.write(cctx.compress(data[start:start + 100_000]))
+            if start == 0:
+                f.write(b'\x50\x2a\x4d\x18\x04\x00\x00\x00skip')
+
+    reader = CheckpointedZstdReader(path)
+    assert reader.read() == data
+    assert reader.checkpoints == list(range(0, len(data), 100_000))
+
+    for pos in rng.integers(0, len(data), 100):
+        assert reader.seek(pos) == pos
+        assert reader.read(1000) == data[pos:pos + 1000]
+
+    # forward skipping without reading first
+    reader = CheckpointedZstdReader(path)
+    assert reader.seek(950_000) == 950_000
+    assert reader.read(10) == data[950_000:950_010]
+    reader.close()
+
+
+def test_read_ahead():
+    from eventio.base import ReadAheadReader
+
+    testfile = 'tests/resources/one_shower.dat'
+    expected = read_objects(testfile)
+
+    for zcat in (True, False):
+        with eventio.EventIOFile(testfile + '.gz', zcat=zcat, read_ahead=2) as f:
+            assert isinstance(f._filehandle, ReadAheadReader)
+            objects = list(f)
+            assert [o.header.type for o in objects] == [t for t, _ in expected]
+
+            # objects are completely in memory, so they can be read in any order
+            for o, (eventio_type, data) in zip(objects[::-1], expected[::-1]):
+                o.seek(0)
+                assert o.read() == data
+
+
+def test_read_ahead_reader():
+    from io import BytesIO
+    from eventio.base import ReadAheadReader
+
+    data = bytes(range(256)) * 100
+    reader = ReadAheadReader(BytesIO(data), depth=2, block_size=1000)
+
+    assert reader.read(10) == data[:10]
+    assert bytes(reader.view(2000)) == data[10:2010]
+    assert reader.seek(5000) == 5000
+    assert reader.tell() == 5000
+    assert reader.read(1) == data[5000:5001]
+
+    with pytest.raises(IOError):
+        reader.seek(0)
+
+    assert reader.read() == data[5001:]
+    assert reader.read(10) == b''
+    reader.close()
+
+
+def test_pipe_wrapper_skip():
+    from io import BytesIO
+    from eventio.base import PipeWrapper, SKIP_BUFFER_SIZE
+
+    data = bytes(range(256)) * 1000
+    pipe = PipeWrapper(BytesIO(data))
+
+    assert pipe.read(10) == data[:10]
+    # larger than the scratch buffer
+    target = 10 + 2 * SKIP_BUFFER_SIZE + 17
+    assert pipe.seek(target) == target
+    assert pipe.read(5) == data[target:target + 5]
+    assert pipe.seek(100, 1) == target + 105
+    assert pipe.read(1) == data[target + 105:target + 106]
+
+    with pytest.raises(IOError):
+        pipe.seek(0)
+
+    # seeking beyond the end stops at the end
+    assert pipe.seek(len(data) + 100) == len(data)
+    assert pipe.read() == b''
+
+
+def write_bgzf(path, data, block_size=65280):
+    '''Write data as BGZF file, gzip members with their size in the header'''
+    import struct
+    import zlib
+
+    with open(path, 'wb') as f:
+        for start in range(0, len(data), block_size):
+            block = data[start:start + block_size]
+            compressor = zlib.compressobj(6, zlib.DEFLATED, -15)
+            compressed = compressor.compress(block) + compressor.flush()
+            total_size = 18 + len(compressed) + 8
+
+            f.write(b'\x1f\x8b\x08\x04\x00\x00\x00\x00\x00\xff')
+            f.write(struct.pack('<H2sHH', 6, b'BC', 2, total_size - 1))
+            f.write(compressed)
+            f.write(struct.pack('<II', zlib.crc32(block), len(block)))
+
+
+def test_parallel_bgzf(tmp_path):
+    from eventio.compression import ParallelFrameReader, is_bgzf
+
+    testfile = 'tests/resources/one_shower.dat'
+    with open(testfile, 'rb') as f:
+        data = f.read()
+
+    path = str(tmp_path / 'one_shower.dat.gz')
+    write_bgzf(path, data, block_size=10000)
+    assert is_bgzf(path)
+    assert not is_bgzf(testfile + '.gz')
+
+    expected = read_objects(testfile)
+
+    with eventio.EventIOFile(path, decompression_threads=3) as f:
+        assert isinstance(f._filehandle, ParallelFrameReader)
+        assert object_contents(f) == expected
+
+
+def test_parallel_zstd(tmp_path):
+    zstd = pytest.importorskip('zstandard')
+    from eventio.compression import ParallelFrameReader, is_multiframe_zstd
+
+    testfile = 'tests/resources/one_shower.dat'
+    with open(testfile, 'rb') as f:
+        data = f.read()
+
+    path = str(tmp_path / 'one_shower.dat.zst')
+    cctx = zstd.ZstdCompressor()
+    with open(path, 'wb') as f:
+        for start in range(0, len(data), 10000):
+            f.write(cctx.compress(data[start:start + 10000]))
+    assert is_multiframe_zstd(path)
+
+    expected = read_objects(testfile)
+
+    with eventio.EventIOFile(path, decompression_threads=3) as f:
+        assert isinstance(f._filehandle, ParallelFrameReader)
+        assert object_contents(f) == expected
+
+    # the single threaded reader also has to read all frames
+    with eventio.EventIOFile(path) as f:
+        assert object_contents(f) == expected
@@ -12,3 +12,28 @@ def test_find_all_subobjects():
         )
 
         assert len(adcsamps) == 50
+
+
+def test_yield_toplevel_of_type_mmap():
+    from eventio import EventIOFile
+    from eventio.search_utils import yield_toplevel_of_type
+    from eventio.iact import TelescopeData, EventEnd
+
+    testfile = 'tests/resources/one_shower.dat'
+
+    with EventIOFile(testfile, mmap=False) as f:
+        expected = [
+            o.header.content_address
+            for o in yield_toplevel_of_type(f, (TelescopeData, EventEnd))
+        ]
+
+    with EventIOFile(testfile) as f:
+        positions = [
+            o.header.content_address
+            for o in yield_toplevel_of_type(f, (TelescopeData, EventEnd))
+        ]
+        # iteration continues after the last complete object
+        assert list(f) == []
+
+    assert len(expected) > 0
+    assert positions == expected
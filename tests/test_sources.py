@@ -0,0 +1,129 @@
+import http.server
+import os
+import re
+import socketserver
+import threading
+
+import pytest
+from eventio import EventIOFile, SimTelFile
+
+from helpers import object_contents, read_objects
+
+simple_corsika = 'tests/resources/one_shower.dat'
+prod2_path = 'tests/resources/gamma_test.simtel.gz'
+
+
+class RangeRequestHandler(http.server.BaseHTTPRequestHandler):
+    '''Serves the files in tests/resources, only supports range requests'''
+    requests = []
+
+    def log_message(self, *args):
+        pass
+
+    def do_GET(self):
+        path = os.path.join('tests/resources', os.path.basename(self.path))
+        if not os.path.isfile(path):
+            self.send_response(404)
+            self.end_headers()
+            return
+
+        size = os.path.getsize(path)
+        start, stop = map(int, re.match(r'bytes=(\d+)-(\d+)', self.headers['Range']).groups())
+        stop = min(stop + 1, size)
+        self.requests.append((self.path, start, stop))
+
+        with open(path, 'rb') as f:
+            f.seek(start)
+            body = f.read(stop - start)
+
+        self.send_response(206)
+        self.send_header('Content-Range', 'bytes {}-{}/{}'.format(start, stop - 1, size))
+        self.send_header('Content-Length', str(len(body)))
+        self.end_headers()
+        self.wfile.write(body)
+
+
+class Server(socketserver.ThreadingMixIn, http.server.HTTPServer):
+    daemon_threads = True
+
+
+@pytest.fixture(scope='module')
+def base_url():
+    server = Server(('127.0.0.1', 0), RangeRequestHandler)
+    thread = threading.Thread(target=server.serve_forever, daemon=True)
+    thread.start()
+    yield 'http://127.0.0.1:{}/'.format(server.server_port)
+    server.shutdown()
+
+
+def test_coalesce_ranges():
+    from eventio.sources import coalesce_ranges
+
+    ranges = [(10, 20), (0, 5), (25, 30), (100, 110)]
+    assert coalesce_ranges(ranges, max_gap=5) == [(0, 30, [1, 0, 2]), (100, 110, [3])]
+    assert coalesce_ranges(ranges, max_gap=0) == [
+        (0, 5, [1]), (10, 20, [0]), (25, 30, [2]), (100, 110, [3])
+    ]
+
+
+def test_source_file():
+    from eventio.sources import LocalSource
+
+    with open(prod2_path, 'rb') as f:
+        data = f.read()
+
+    with LocalSource(prod2_path).open(block_size=1000, max_in_flight=3) as f:
+        assert f.read(10) == data[:10]
+        assert f.read(5000) == data[10:5010]
+        f.seek(-100, 2)
+        assert f.read() == data[-100:]
+        assert f.read() == b''
+        f.seek(2500)
+        assert f.read(1) == data[2500:2501]
+
+
+@pytest.mark.parametrize('path', [simple_corsika, prod2_path])
+def test_eventio_file_http(base_url, path):
+    expected = read_objects(path)
+    assert read_objects(base_url + os.path.basename(path)) == expected
+
+
+def test_simtel_file_http(base_url):
+    with SimTelFile(prod2_path) as f:
+        expected = [e['event_id'] for e in f]
+
+    with SimTelFile(base_url + os.path.basename(prod2_path)) as f:
+        assert [e['event_id'] for e in f] == expected
+
+
+def test_fetch_objects(base_url, tmp_path):
+    from eventio.index import EventIOIndex
+    from eventio.sources import fetch_objects
+
+    url = base_url + os.path.basename(simple_corsika)
+    index_path = str(tmp_path / 'one_shower.dat.eventio-idx')
+
+    # the index of a remote file can be stored locally
+    index = EventIOIndex.for_file(url, max_depth=0, index_path=index_path)
+    assert os.path.isfile(index_path)
+    rows = index.toplevel[[1, 3]]
+
+    with EventIOFile(simple_corsika) as f:
+        objects = list(f)
+        expected = object_contents([objects[i] for i in (1, 3)])
+
+    RangeRequestHandler.requests.clear()
+    fetched = fetch_objects(url, rows)
+    assert object_contents(fetched) == expected
+    # only the requested objects were read
+    assert max(stop for _, _, stop in RangeRequestHandler.requests) <= (
+        int(rows[-1]['offset']) + int(rows[-1]['header_size']) + int(rows[-1]['size'])
+    )
+
+
+def test_remote_not_found(base_url):
+    from eventio.sources import as_source
+
+    assert not as_source(base_url + 'does_not_exist.dat').exists()
+    with pytest.raises(FileNotFoundError):
+        EventIOFile(base_url + 'does_not_exist.dat')
@@ -0,0 +1,171 @@
+import numpy as np
+import pytest
+
+from eventio.tools import encode_unsigned_varint, encode_varint
+
+
+values = [0, 1, 127, 128, 2**14 - 1, 2**14, 2**21 + 5, 2**28 + 7, 2**35, 2**49, 2**56 + 3, 2**63 - 1]
+signed_values = [0, -1, 1, 63, -64, 64, -65, 2**20, -2**20, 2**40, -2**62]
+
+
+def test_unsigned_varint_array():
+    from eventio.var_int import unsigned_varint_array
+
+    data = b'\x00' + b''.join(encode_unsigned_varint(v) for v in values)
+    result, length = unsigned_varint_array(data, len(values), offset=1)
+
+    assert result.tolist() == values
+    assert length == len(data) - 1
+
+
+def test_varint_array():
+    from eventio.var_int import varint_array
+
+    data = b''.join(encode_varint(v) for v in signed_values)
+    result, length = varint_array(data, len(signed_values))
+
+    assert result.tolist() == signed_values
+    assert length == len(data)
+
+
+def test_unsigned_varint_arrays_differential():
+    from eventio.var_int import unsigned_varint_arrays_differential
+
+    rng = np.random.default_rng(0)
+    expected = rng.integers(0, 2**16, (3, 50), dtype=np.uint32)
+    expected[:, :10] = 300  # mostly one byte differences
+
+    data = b''.join(
+        encode_varint(int(d))
+        for row in expected
+        for d in np.diff(row.astype(np.int64), prepend=0)
+    )
+
+    result, length = unsigned_varint_arrays_differential(data, 3, 50)
+    assert length == len(data)
+    assert np.all(result == expected)
+
+
+def test_truncated_data():
+    from eventio.var_int import (
+        unsigned_varint_array,
+        varint_array,
+        unsigned_varint_arrays_differential,
+    )
+
+    data = b''.join(encode_varint(v) for v in signed_values)
+
+    for func in (unsigned_varint_array, varint_array):
+        with pytest.raises(IndexError):
+            func(data[:-1], len(signed_values))
+
+    with pytest.raises(IndexError):
+        unsigned_varint_arrays_differential(data[:-1], 1, len(signed_values))
+
+
+def test_empty_data():
+    from eventio.var_int import varint_array, unsigned_varint_arrays_differential
+
+    result, length = varint_array(b'', 0)
+    assert len(result) == 0
+    assert length == 0
+
+    result, length = unsigned_varint_arrays_differential(b'', 2, 0)
+    assert result.shape == (2, 0)
+
+    with pytest.raises(IndexError):
+        varint_array(b'', 1)
+
+
+def test_sector_information_v2():
+    from eventio.var_int import read_sector_information_v2
+
+    sectors = [[1, 2, 3], [], [5]]
+    data = b''.join(
+        encode_varint(len(s)) + b''.join(encode_varint(v) for v in s)
+        for s in sectors
+    )
+
+    result, length = read_sector_information_v2(data, len(sectors))
+    assert [r.tolist() for r in result] == sectors
+    assert length == len(data)
+    assert result.offsets.tolist() == [0, 3, 3, 4]
+    assert result.values.tolist() == [1, 2, 3, 5]
+    assert result[-1].tolist() == [5]
+    assert [r.tolist() for r in result[1:]] == sectors[1:]
+    with pytest.raises(IndexError):
+        result[3]
+
+    with pytest.raises(IndexError):
+        read_sector_information_v2(data[:-1], len(sectors))
+
+
+@pytest.mark.parametrize('n_elements', [1, 15, 16, 17, 100, 1000])
+def test_differential_simd_matches_scalar(n_elements):
+    from eventio.var_int import unsigned_varint_arrays_differential
+
+    rng = np.random.default_rng(n_elements)
+    # long runs of single byte differences with a few large jumps
+    diffs = rng.integers(-64, 64, (2, n_elements))
+    jumps = rng.random((2, n_elements)) < 0.02
+    diffs[jumps] = rng.integers(-2**20, 2**20, np.count_nonzero(jumps))
+
+    data = b''.join(encode_varint(int(d)) for d in diffs.ravel())
+    expected = np.cumsum(diffs, axis=1).astype(np.uint32)
+
+    result, length = unsigned_varint_arrays_differential(data, 2, n_elements)
+    scalar, scalar_length = unsigned_varint_arrays_differential(
+        data, 2, n_elements, simd=False
+    )
+
+    assert length == scalar_length == len(data)
+    assert np.all(result == expected)
+    assert np.all(scalar == expected)
+
+    with pytest.raises(IndexError):
+        unsigned_varint_arrays_differential(data[:-1], 2, n_elements)
+
+
+def test_parse_photoelectrons_unsorted():
+    import struct
+    from eventio.var_int import parse_photoelectrons
+
+    # version 2: int16 pixel ids, flags with amplitudes, pixels not in order
+    pixels = {3: [1.0, 2.0], 0: [5.0]}
+    n_pe = sum(len(t) for t in pixels.values())
+    data = struct.pack('<iihi', n_pe, 4, 1, len(pixels))
+    for pixel_id, times in pixels.items():
+        data += struct.pack('<hi', pixel_id, len(times))
+        data += struct.pack('<{}f'.format(len(times)), *times)
+        data += struct.pack('<{}f'.format(len(times)), *[10 * t for t in times])
+
+    result = parse_photoelectrons(data, 2)
+    assert result['n_pe'] == 3
+    assert result['photoelectrons'].tolist() == [1, 0, 0, 2]
+    assert result['pixel_offsets'].tolist() == [0, 1, 1, 1, 3]
+    assert result['pixel_id'].tolist() == [0, 3, 3]
+    assert result['time'].tolist() == [5.0, 1.0, 2.0]
+    assert result['amplitude'].tolist() == [50.0, 10.0, 20.0]
+    assert 'photons' not in result
+
+    with pytest.raises(IndexError):
+        parse_photoelectrons(data[:-1], 2)
+
+
+def test_parse_photoelectrons_short_unsorted():
+    import struct
+    from eventio.var_int import parse_photoelectrons, parse_photoelectrons_merged
+
+    # header claims more photo electrons than the pixels contain,
+    # the zero padding must stay behind the sorted entries
+    pixels = {3: [1.0, 2.0], 1: [5.0]}
+    data = struct.pack('<iihi', 5, 4, 0, len(pixels))
+    for pixel_id, times in pixels.items():
+        data += struct.pack('<hi', pixel_id, len(times))
+        data += struct.pack('<{}f'.format(len(times)), *times)
+
+    for result in (parse_photoelectrons(data, 2), parse_photoelectrons_merged([data], [2])):
+        assert result['photoelectrons'].tolist() == [0, 1, 0, 2]
+        assert result['pixel_offsets'].tolist() == [0, 0, 1, 1, 3]
+        assert result['pixel_id'].tolist() == [1, 3, 3, 0, 0]
+        assert result['time'].tolist() == [5.0, 1.0, 2.0, 0.0, 0.0]
@@ -0,0 +1,152 @@
+import pytest
+from eventio import EventIOFile
+
+from helpers import read_objects
+
+
+simple_corsika = 'tests/resources/one_shower.dat'
+prod2_path = 'tests/resources/gamma_test.simtel.gz'
+
+
+def test_encode_header():
+    from eventio.writer import encode_header
+
+    with open(simple_corsika, 'rb') as f:
+        data = f.read()
+
+    with EventIOFile(simple_corsika) as f:
+        for o in f:
+            start = o.header.content_address - o.header.header_size
+            assert encode_header(o.header) == data[start:o.header.content_address]
+
+            o.seek(0)
+            if o.only_subobjects:
+                for sub in o:
+                    start = sub.header.content_address - sub.header.header_size
+                    encoded = encode_header(sub.header, toplevel=False)
+                    assert encoded == data[start:sub.header.content_address]
+
+
+def test_encode_header_extension():
+    from eventio.header import parse_header_bytes
+    from eventio.base import parse_extension_field
+    from eventio.writer import encode_header
+
+    with EventIOFile(simple_corsika) as f:
+        header = next(f).header
+
+    size = 2**31 + 5
+    data = encode_header(header, size, toplevel=False)
+    assert len(data) == 16
+
+    parsed = parse_header_bytes(data[:12])
+    assert parsed.extended
+    assert parsed.type == header.type
+    assert parsed.content_size + parse_extension_field(data[12:]) == size
+
+
+def test_write_uncompressed(tmp_path):
+    from eventio.writer import repack
+
+    path = str(tmp_path / 'one_shower.dat')
+    assert repack(simple_corsika, path) == 8
+
+    with open(simple_corsika, 'rb') as f, open(path, 'rb') as f_out:
+        assert f_out.read() == f.read()
+
+
+def test_write_zstd(tmp_path):
+    zstd = pytest.importorskip('zstandard')
+    from eventio.compression import is_multiframe_zstd, read_zstd_seek_table
+
+    from eventio.writer import repack
+
+    path = str(tmp_path / 'one_shower.dat.zst')
+    repack(simple_corsika, path, frame_size=2000, n_threads=2)
+    assert is_multiframe_zstd(path)
+
+    with open(simple_corsika, 'rb') as f:
+        data = f.read()
+
+    with open(path, 'rb') as f:
+        assert zstd.ZstdDecompressor().stream_reader(
+            f, read_across_frames=True
+        ).read() == data
+
+        seek_table = read_zstd_seek_table(f)
+
+    # frames start at toplevel objects
+    with EventIOFile(simple_corsika) as f:
+        starts = {o.header.content_address - o.header.header_size for o in f}
+    assert len(seek_table) > 1
+    assert {frame[1] for frame in seek_table} <= starts
+    assert sum(frame[3] for frame in seek_table) == len(data)
+
+    expected = read_objects(simple_corsika)
+    assert read_objects(path, decompression_threads=3) == expected
+
+    # all frames are known to the seekable reader right away
+    with EventIOFile(path, seekable=True) as f:
+        assert f._filehandle.checkpoints == [frame[1] for frame in seek_table]
+        f.seek(len(data) - 100)
+        assert f.read() == data[-100:]
+
+
+def test_repack_types(tmp_path):
+    from eventio.writer import repack
+
+    path = str(tmp_path / 'one_shower.dat')
+    with EventIOFile(simple_corsika) as f:
+        types = [o.header.type for o in f]
+
+    assert repack(simple_corsika, path, types=[1202, 1209]) == 2
+
+    with EventIOFile(path) as f:
+        assert [o.header.type for o in f] == [t for t in types if t in (1202, 1209)]
+
+
+def test_repack_telescopes(tmp_path):
+    from eventio import SimTelFile
+    from eventio.writer import repack
+
+    telescopes = set(range(1, 40))
+    path = str(tmp_path / 'gamma_test.simtel')
+    repack(prod2_path, path, telescopes=telescopes)
+
+    with SimTelFile(prod2_path, allowed_telescopes=telescopes) as f:
+        expected = [
+            (e['event_id'], set(e['telescope_events'])) for e in f
+        ]
+
+    with SimTelFile(path) as f:
+        # all telescope descriptions are kept
+        assert len(f.telescope_descriptions) == f.n_telescopes
+
+        result = [
+            (e['event_id'], set(e['telescope_events']))
+            for e in f
+            if e['telescope_events']
+        ]
+
+    assert result == expected
+    assert all(tel_ids <= telescopes for _, tel_ids in result)
+
+    # photons are stored by telescope index, which is telescope id - 1
+    photons_path = 'tests/resources/lst_with_photons.simtel.zst'
+    for telescopes in ({1}, {2}):
+        path = str(tmp_path / 'lst_with_photons_{}.simtel'.format(min(telescopes)))
+        repack(photons_path, path, telescopes=telescopes)
+
+        with SimTelFile(photons_path, allowed_telescopes=telescopes) as f:
+            expected = [
+                (e['event_id'], set(e.get('photons', {}))) for e in f.iter_mc_events()
+            ]
+
+        with SimTelFile(path) as f:
+            result = [
+                (e['event_id'], set(e.get('photons', {}))) for e in f.iter_mc_events()
+            ]
+
+        assert result == expected
+        # the file only contains photons of telescope 1
+        assert any(photons for _, photons in expected) == (telescopes == {1})